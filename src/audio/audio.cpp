@@ -0,0 +1,345 @@
+#include "audio.h"
+
+#include "../util/config.h"
+
+#include <SDL.h>
+
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AUDIO_USE_SSE 1
+#endif
+
+namespace
+{
+    static_assert((AUDIO_COMMAND_CAPACITY & (AUDIO_COMMAND_CAPACITY - 1)) == 0, "AUDIO_COMMAND_CAPACITY must be a power of two");
+
+    // 每种音效同时发声的上限（连续命中时不会占满所有声道）
+    const int kVoiceLimit[SOUND_COUNT] = {4, 8, 8};
+    const double kPi = 3.14159265358979323846;
+
+    // 播放命令（增益在游戏线程算好，回调只做乘加）
+    struct AudioCommand
+    {
+        int sound;
+        float gainLeft;
+        float gainRight;
+    };
+
+    // 一个正在发声的声音
+    struct Voice
+    {
+        int sound;           // -1 = 空闲
+        int position;        // 已播放的采样数
+        float gainLeft;
+        float gainRight;
+        unsigned int serial; // 开始顺序，越小越早
+    };
+
+    SDL_AudioDeviceID g_device = 0;
+    int g_frequency = AUDIO_FREQUENCY;
+
+    // 预先合成的单声道 PCM（初始化后只读）
+    std::vector<float> g_sounds[SOUND_COUNT];
+
+    // 单生产者/单消费者环形队列：游戏线程只写 g_tail，回调只写 g_head
+    AudioCommand g_commands[AUDIO_COMMAND_CAPACITY];
+    std::atomic<unsigned int> g_head{0};
+    std::atomic<unsigned int> g_tail{0};
+
+    // 以下只在回调线程中访问（统计值以原子变量发布）
+    Voice g_voices[AUDIO_MAX_VOICES];
+    unsigned int g_nextSerial = 0;
+    float g_mix[AUDIO_BUFFER_SAMPLES * 2 * 4];  // 回调缓冲大于它时分段混音
+    std::atomic<int> g_activeVoices{0};
+    std::atomic<int> g_droppedCommands{0};
+    std::atomic<int> g_stolenVoices{0};
+
+    // ===== 音效合成 =====
+    unsigned int g_noise = 0x12345678u;
+
+    float Noise()
+    {
+        g_noise ^= g_noise << 13;
+        g_noise ^= g_noise >> 17;
+        g_noise ^= g_noise << 5;
+        return static_cast<float>(g_noise) / 2147483648.0f - 1.0f;
+    }
+
+    // 开火：从 1200 Hz 滑到 500 Hz 的方波，线性衰减
+    void SynthesizeShot(std::vector<float>& out)
+    {
+        int count = g_frequency * 8 / 100;
+        out.resize(count);
+        double phase = 0.0;
+        for (int i = 0; i < count; ++i)
+        {
+            double t = static_cast<double>(i) / count;
+            phase += (1200.0 - 700.0 * t) / g_frequency;
+            float square = std::fmod(phase, 1.0) < 0.5 ? 1.0f : -1.0f;
+            out[i] = 0.18f * square * static_cast<float>(1.0 - t);
+        }
+    }
+
+    // 命中：短促的噪声 + 高音，指数衰减
+    void SynthesizeHit(std::vector<float>& out)
+    {
+        int count = g_frequency * 6 / 100;
+        out.resize(count);
+        for (int i = 0; i < count; ++i)
+        {
+            double t = static_cast<double>(i) / g_frequency;
+            float envelope = static_cast<float>(std::exp(-t * 60.0));
+            float tone = static_cast<float>(std::sin(2.0 * kPi * 1800.0 * t));
+            out[i] = 0.3f * envelope * (0.6f * Noise() + 0.4f * tone);
+        }
+    }
+
+    // 爆炸：低通滤波的噪声，缓慢衰减
+    void SynthesizeExplosion(std::vector<float>& out)
+    {
+        int count = g_frequency * 6 / 10;
+        out.resize(count);
+        float lowpass = 0.0f;
+        for (int i = 0; i < count; ++i)
+        {
+            double t = static_cast<double>(i) / g_frequency;
+            lowpass += 0.08f * (Noise() - lowpass);
+            float envelope = static_cast<float>(std::exp(-t * 6.0));
+            out[i] = 1.6f * envelope * lowpass;
+        }
+    }
+
+    // ===== 回调线程 =====
+    // 为新声音找一个声道：空闲声道 → 同类超出上限时抢占同类最早的 → 抢占全部中最早的
+    Voice* AcquireVoice(int sound)
+    {
+        Voice* freeVoice = nullptr;
+        Voice* oldestSame = nullptr;
+        Voice* oldest = nullptr;
+        int sameCount = 0;
+        for (Voice& v : g_voices)
+        {
+            if (v.sound < 0)
+            {
+                if (!freeVoice)
+                    freeVoice = &v;
+                continue;
+            }
+            if (!oldest || v.serial < oldest->serial)
+                oldest = &v;
+            if (v.sound == sound)
+            {
+                sameCount++;
+                if (!oldestSame || v.serial < oldestSame->serial)
+                    oldestSame = &v;
+            }
+        }
+
+        if (sameCount >= kVoiceLimit[sound])
+        {
+            g_stolenVoices.fetch_add(1, std::memory_order_relaxed);
+            return oldestSame;
+        }
+        if (freeVoice)
+            return freeVoice;
+        g_stolenVoices.fetch_add(1, std::memory_order_relaxed);
+        return oldest;
+    }
+
+    void ConsumeCommands()
+    {
+        unsigned int head = g_head.load(std::memory_order_relaxed);
+        unsigned int tail = g_tail.load(std::memory_order_acquire);
+        for (; head != tail; ++head)
+        {
+            const AudioCommand& command = g_commands[head & (AUDIO_COMMAND_CAPACITY - 1)];
+            Voice* voice = AcquireVoice(command.sound);
+            voice->sound = command.sound;
+            voice->position = 0;
+            voice->gainLeft = command.gainLeft;
+            voice->gainRight = command.gainRight;
+            voice->serial = g_nextSerial++;
+        }
+        g_head.store(head, std::memory_order_release);
+    }
+
+    // 把单声道采样按左右增益叠加到交错立体声缓冲中
+    void MixVoice(float* out, const float* samples, int count, float gainLeft, float gainRight)
+    {
+        int i = 0;
+#ifdef AUDIO_USE_SSE
+        const __m128 left = _mm_set1_ps(gainLeft);
+        const __m128 right = _mm_set1_ps(gainRight);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 s = _mm_loadu_ps(samples + i);
+            __m128 l = _mm_mul_ps(s, left);
+            __m128 r = _mm_mul_ps(s, right);
+            // 交错为 L0 R0 L1 R1 | L2 R2 L3 R3
+            __m128 lo = _mm_unpacklo_ps(l, r);
+            __m128 hi = _mm_unpackhi_ps(l, r);
+            _mm_storeu_ps(out + i * 2, _mm_add_ps(_mm_loadu_ps(out + i * 2), lo));
+            _mm_storeu_ps(out + i * 2 + 4, _mm_add_ps(_mm_loadu_ps(out + i * 2 + 4), hi));
+        }
+#endif
+        // 剩余部分（或不支持 SSE 时的全部）用标量循环
+        for (; i < count; ++i)
+        {
+            out[i * 2] += samples[i] * gainLeft;
+            out[i * 2 + 1] += samples[i] * gainRight;
+        }
+    }
+
+    // 乘以总音量并限制到 [-1, 1]
+    void Finalize(float* out, const float* mix, int sampleCount)
+    {
+        int i = 0;
+#ifdef AUDIO_USE_SSE
+        const __m128 gain = _mm_set1_ps(AUDIO_MASTER_VOLUME);
+        const __m128 hi = _mm_set1_ps(1.0f);
+        const __m128 lo = _mm_set1_ps(-1.0f);
+        for (; i + 4 <= sampleCount; i += 4)
+        {
+            __m128 v = _mm_mul_ps(_mm_loadu_ps(mix + i), gain);
+            _mm_storeu_ps(out + i, _mm_max_ps(lo, _mm_min_ps(hi, v)));
+        }
+#endif
+        for (; i < sampleCount; ++i)
+        {
+            float v = mix[i] * AUDIO_MASTER_VOLUME;
+            out[i] = v > 1.0f ? 1.0f : (v < -1.0f ? -1.0f : v);
+        }
+    }
+
+    void SDLCALL AudioCallback(void*, Uint8* stream, int length)
+    {
+        ConsumeCommands();
+
+        float* out = reinterpret_cast<float*>(stream);
+        int frames = length / static_cast<int>(sizeof(float) * 2);
+        const int chunkFrames = static_cast<int>(sizeof(g_mix) / sizeof(float) / 2);
+
+        while (frames > 0)
+        {
+            int n = frames < chunkFrames ? frames : chunkFrames;
+            SDL_memset(g_mix, 0, sizeof(float) * 2 * n);
+
+            for (Voice& v : g_voices)
+            {
+                if (v.sound < 0)
+                    continue;
+                const std::vector<float>& pcm = g_sounds[v.sound];
+                int remaining = static_cast<int>(pcm.size()) - v.position;
+                int count = remaining < n ? remaining : n;
+                MixVoice(g_mix, pcm.data() + v.position, count, v.gainLeft, v.gainRight);
+                v.position += count;
+                if (v.position >= static_cast<int>(pcm.size()))
+                    v.sound = -1;  // 播放完毕，释放声道
+            }
+
+            Finalize(out, g_mix, n * 2);
+            out += n * 2;
+            frames -= n;
+        }
+
+        int active = 0;
+        for (const Voice& v : g_voices)
+            active += v.sound >= 0 ? 1 : 0;
+        g_activeVoices.store(active, std::memory_order_relaxed);
+    }
+}
+
+bool AudioInit()
+{
+    if (g_device)
+        return true;
+
+    SDL_AudioSpec desired = {};
+    desired.freq = AUDIO_FREQUENCY;
+    desired.format = AUDIO_F32SYS;
+    desired.channels = 2;
+    desired.samples = AUDIO_BUFFER_SAMPLES;
+    desired.callback = AudioCallback;
+
+    SDL_AudioSpec obtained = {};
+    g_device = SDL_OpenAudioDevice(nullptr, 0, &desired, &obtained, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
+    if (!g_device)
+    {
+        SDL_Log("AudioInit: SDL_OpenAudioDevice failed - %s", SDL_GetError());
+        return false;
+    }
+
+    // 按设备的实际采样率合成，回调中不需要重采样
+    g_frequency = obtained.freq;
+    SynthesizeShot(g_sounds[SOUND_SHOT]);
+    SynthesizeHit(g_sounds[SOUND_HIT]);
+    SynthesizeExplosion(g_sounds[SOUND_EXPLOSION]);
+
+    for (Voice& v : g_voices)
+        v.sound = -1;
+    g_head.store(0);
+    g_tail.store(0);
+
+    SDL_PauseAudioDevice(g_device, 0);
+    return true;
+}
+
+void AudioShutdown()
+{
+    if (!g_device)
+        return;
+    SDL_CloseAudioDevice(g_device);
+    g_device = 0;
+    for (std::vector<float>& pcm : g_sounds)
+        std::vector<float>().swap(pcm);
+}
+
+void AudioPlay(SoundId sound, float volume, float pan)
+{
+    if (!g_device || sound < 0 || sound >= SOUND_COUNT)
+        return;
+
+    unsigned int tail = g_tail.load(std::memory_order_relaxed);
+    unsigned int head = g_head.load(std::memory_order_acquire);
+    if (tail - head >= AUDIO_COMMAND_CAPACITY)
+    {
+        g_droppedCommands.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // 等功率声像
+    if (pan < -1.0f)
+        pan = -1.0f;
+    if (pan > 1.0f)
+        pan = 1.0f;
+    float angle = (pan + 1.0f) * 0.25f * static_cast<float>(kPi);
+    AudioCommand& command = g_commands[tail & (AUDIO_COMMAND_CAPACITY - 1)];
+    command.sound = sound;
+    command.gainLeft = volume * std::cos(angle);
+    command.gainRight = volume * std::sin(angle);
+    g_tail.store(tail + 1, std::memory_order_release);
+}
+
+float AudioPanForX(double x)
+{
+    return static_cast<float>(x / GAME_WIDTH * 2.0 - 1.0);
+}
+
+int AudioGetActiveVoices()
+{
+    return g_activeVoices.load(std::memory_order_relaxed);
+}
+
+int AudioGetDroppedCommands()
+{
+    return g_droppedCommands.load(std::memory_order_relaxed);
+}
+
+int AudioGetStolenVoices()
+{
+    return g_stolenVoices.load(std::memory_order_relaxed);
+}
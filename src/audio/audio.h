@@ -0,0 +1,34 @@
+#pragma once
+
+// ===== 音效混音 =====
+// 音效在初始化时按设备采样率合成为 PCM 并常驻内存；
+// 游戏线程通过无锁单生产者/单消费者队列发送播放命令，SDL 音频回调里完成混音，
+// 回调中不加锁、不分配内存；发声数有上限，超出时抢占同类中（或全部中）最早开始的声音
+
+// 音效种类
+enum SoundId
+{
+    SOUND_SHOT = 0,     // 玩家开火
+    SOUND_HIT,          // 子弹命中
+    SOUND_EXPLOSION,    // 爆炸
+    SOUND_COUNT
+};
+
+// 打开音频设备并合成音效（需要先以 SDL_INIT_AUDIO 初始化 SDL）
+// 没有可用设备时返回 false，之后的播放请求被忽略
+bool AudioInit();
+
+// 关闭音频设备并释放音效
+void AudioShutdown();
+
+// 播放一个音效（只在游戏线程调用）
+// volume 为 0~1，pan 为 -1（左）~ 1（右）；队列满时丢弃并计数
+void AudioPlay(SoundId sound, float volume, float pan);
+
+// 按游戏区域内的横坐标计算声像（-1 ~ 1）
+float AudioPanForX(double x);
+
+// 统计信息
+int AudioGetActiveVoices();      // 上一次回调结束时正在发声的数量
+int AudioGetDroppedCommands();   // 因队列已满被丢弃的播放请求
+int AudioGetStolenVoices();      // 被抢占的声音
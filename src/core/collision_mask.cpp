@@ -0,0 +1,153 @@
+#include "collision_mask.h"
+
+#include "../util/config.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    CollisionMask g_masks[SPRITE_COUNT];
+    bool g_built = false;
+
+    // 从一行（words 个字）中取出从第 start 位开始的 64 位，越界部分为 0
+    uint64_t ExtractBits(const uint64_t* row, int words, int start)
+    {
+        int word = start >= 0 ? start / 64 : -((-start + 63) / 64);
+        int shift = start - word * 64;  // 0..63
+        uint64_t lo = (word >= 0 && word < words) ? row[word] : 0;
+        uint64_t hi = (word + 1 >= 0 && word + 1 < words) ? row[word + 1] : 0;
+        return shift == 0 ? lo : (lo >> shift) | (hi << (64 - shift));
+    }
+
+    // 第 base 位起的 64 位中，落在 [from, to] 内的位全部置 1
+    uint64_t SpanBits(int from, int to, int base)
+    {
+        int lo = std::max(from - base, 0);
+        int hi = std::min(to - base, 63);
+        if (lo > hi)
+            return 0;
+        return (~0ull >> (63 - hi)) & (~0ull << lo);
+    }
+
+    int Floor(double value)
+    {
+        return static_cast<int>(std::floor(value));
+    }
+}
+
+void CollisionMasksBuild()
+{
+    CollisionMasksClear();
+
+    int atlasWidth = 0, atlasHeight = 0;
+    const unsigned char* pixels = GetSpriteAtlasPixels(atlasWidth, atlasHeight);
+    if (!pixels)
+        return;
+
+    for (int id = 0; id < SPRITE_COUNT; ++id)
+    {
+        const Sprite* sprite = GetSprite(static_cast<SpriteId>(id));
+        if (!sprite)
+            continue;
+
+        CollisionMask& mask = g_masks[id];
+        mask.width = sprite->w;
+        mask.height = sprite->h;
+        mask.wordsPerRow = (sprite->w + 63) / 64;
+        mask.offsetX = -static_cast<int>(std::lround(sprite->pivotX));
+        mask.offsetY = -static_cast<int>(std::lround(sprite->pivotY));
+        mask.rows.assign(static_cast<size_t>(mask.height) * mask.wordsPerRow, 0);
+
+        // 透明度达到阈值的像素参与碰撞
+        for (int y = 0; y < sprite->h; ++y)
+        {
+            const unsigned char* src = pixels + (static_cast<size_t>(sprite->y + y) * atlasWidth + sprite->x) * 4;
+            uint64_t* row = &mask.rows[static_cast<size_t>(y) * mask.wordsPerRow];
+            for (int x = 0; x < sprite->w; ++x)
+            {
+                if (src[x * 4 + 3] >= COLLISION_MASK_ALPHA)
+                    row[x / 64] |= 1ull << (x % 64);
+            }
+        }
+    }
+    g_built = true;
+}
+
+void CollisionMasksClear()
+{
+    for (CollisionMask& mask : g_masks)
+    {
+        mask.rows.clear();
+        mask.width = mask.height = 0;
+    }
+    g_built = false;
+}
+
+const CollisionMask* GetCollisionMask(SpriteId id)
+{
+    if (!g_built || id < 0 || id >= SPRITE_COUNT || g_masks[id].rows.empty())
+        return nullptr;
+    return &g_masks[id];
+}
+
+bool IsMaskCircleCollision(const CollisionMask& mask, Vector2 position, Circle circle)
+{
+    int left = Floor(position.x) + mask.offsetX;
+    int top = Floor(position.y) + mask.offsetY;
+
+    // 只检查圆形覆盖的行（最多 2r + 1 行）
+    int y0 = std::max(top, Floor(circle.center.y - circle.radius));
+    int y1 = std::min(top + mask.height - 1, Floor(circle.center.y + circle.radius));
+    for (int y = y0; y <= y1; ++y)
+    {
+        double dy = y + 0.5 - circle.center.y;
+        double span = circle.radius * circle.radius - dy * dy;
+        if (span < 0.0)
+            continue;
+        double dx = std::sqrt(span);
+
+        // 圆形在这一行覆盖的列（遮罩局部坐标）
+        int from = static_cast<int>(std::ceil(circle.center.x - dx - 0.5)) - left;
+        int to = Floor(circle.center.x + dx - 0.5) - left;
+        from = std::max(from, 0);
+        to = std::min(to, mask.width - 1);
+        if (from > to)
+            continue;
+
+        const uint64_t* row = &mask.rows[static_cast<size_t>(y - top) * mask.wordsPerRow];
+        for (int w = from / 64; w <= to / 64; ++w)
+        {
+            if (row[w] & SpanBits(from, to, w * 64))
+                return true;
+        }
+    }
+    return false;
+}
+
+bool IsMaskMaskCollision(const CollisionMask& a, Vector2 positionA, const CollisionMask& b, Vector2 positionB)
+{
+    int ax = Floor(positionA.x) + a.offsetX, ay = Floor(positionA.y) + a.offsetY;
+    int bx = Floor(positionB.x) + b.offsetX, by = Floor(positionB.y) + b.offsetY;
+
+    // 重叠区域（全局像素坐标）
+    int x0 = std::max(ax, bx), x1 = std::min(ax + a.width, bx + b.width);
+    int y0 = std::max(ay, by), y1 = std::min(ay + a.height, by + b.height);
+    if (x0 >= x1 || y0 >= y1)
+        return false;
+
+    // 以 a 的字为单位遍历重叠列，b 的行按位移对齐到 a
+    int firstWord = (x0 - ax) / 64;
+    int lastWord = (x1 - 1 - ax) / 64;
+    for (int y = y0; y < y1; ++y)
+    {
+        const uint64_t* rowA = &a.rows[static_cast<size_t>(y - ay) * a.wordsPerRow];
+        const uint64_t* rowB = &b.rows[static_cast<size_t>(y - by) * b.wordsPerRow];
+        for (int w = firstWord; w <= lastWord; ++w)
+        {
+            if (rowA[w] & ExtractBits(rowB, b.wordsPerRow, w * 64 + ax - bx))
+                return true;
+        }
+    }
+    return false;
+}
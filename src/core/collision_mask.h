@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../render/sprite_atlas.h"
+#include "../util/type.h"
+
+#include <cstdint>
+#include <vector>
+
+// ===== 像素级碰撞遮罩 =====
+// 从图集的透明度为每个精灵预先生成 1 位遮罩（每行按 64 位打包），
+// 作为矩形/圆形粗测之后的精确检测：两个遮罩的重叠行逐字 AND（按位移对齐），
+// 开销不超过较矮遮罩的行数 × 每行字数；图集未加载时没有遮罩，碰撞退回到矩形
+
+// 一个精灵的碰撞遮罩
+struct CollisionMask
+{
+    int width;                  // 遮罩尺寸（精灵像素）
+    int height;
+    int wordsPerRow;            // 每行的 64 位字数
+    int offsetX;                // 遮罩左上角相对游戏对象 position 的偏移（= -锚点）
+    int offsetY;
+    std::vector<uint64_t> rows; // height × wordsPerRow，第 x 位对应第 x 列
+};
+
+// 根据已加载的图集生成所有精灵的遮罩（图集未加载时清空）
+void CollisionMasksBuild();
+
+// 释放遮罩
+void CollisionMasksClear();
+
+// 获取精灵的遮罩（没有时返回 nullptr，调用方退回到矩形检测）
+const CollisionMask* GetCollisionMask(SpriteId id);
+
+// 位于 position 的遮罩与圆形是否重叠（按像素中心判断）
+bool IsMaskCircleCollision(const CollisionMask& mask, Vector2 position, Circle circle);
+
+// 分别位于 positionA、positionB 的两个遮罩是否重叠
+bool IsMaskMaskCollision(const CollisionMask& a, Vector2 positionA, const CollisionMask& b, Vector2 positionB);
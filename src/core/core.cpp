@@ -1,108 +1,467 @@
 #include "core.h"
 
+#include "collision_mask.h"
+#include "frame_pacer.h"
+#include "game_event.h"
+#include "governor.h"
+
+#include "../audio/audio.h"
 #include "../game_object/player.h"
 #include "../game_object/enemy.h"
+#include "../game_object/boss.h"
 #include "../game_object/bullet.h"
+#include "../game_object/particle.h"
+#include "../game_object/spatial_index.h"
+#include "../input/input.h"
+#include "../level/level.h"
+#include "../net/session.h"
+#include "../render/background.h"
+#include "../render/sprite_atlas.h"
+#include "../render/sprite_batch.h"
 #include "../ui/hud.h"
+#include "../util/alloc_tracker.h"
 #include "../util/config.h"
+#include "../util/log.h"
+#include "../util/telemetry.h"
 #include "../util/util.h"
 
 #include <SDL.h>
 #include <cstddef>
+#include <cstdio>
+#include <vector>
 
 namespace
 {
+    // 自动测试时代替键盘的输入
+    bool g_inputOverride = false;
+    unsigned int g_overrideBits = 0;
+
+    // 遥测用的本 tick 计数（每次 GameUpdate 开始时清零，由事件处理函数累加）
+    int g_tickHits = 0;
+    int g_tickKills = 0;
+    int g_tickPlayerHits = 0;
+    // 上一次记录时的累计创建数，差值即本 tick 的生成数（包括 GameUpdate 之外创建的）
+    unsigned int g_lastEnemiesCreated = 0;
+    unsigned int g_lastBulletsCreated = 0;
+
+    // 本 tick 已经命中目标的子弹（按子弹下标，事件分发之后统一删除）
+    std::vector<unsigned char> g_bulletSpent;
+
     // 重置游戏状态（玩家死亡时调用）
     void ResetGame()
     {
         CreatePlayer();
         ClearEnemies();
         ClearBullets();
+        ClearBosses();
+        SpatialIndexClear();
+        LevelRestart();
+        g_bulletSpent.reserve(BULLET_CAPACITY);
     }
 
-    // 检测玩家与敌人的碰撞
-    void CheckCollision_Player_Enemies()
+    // 矩形粗测通过后用像素遮罩做精确检测（没有遮罩时以矩形结果为准）
+    bool IsPlayerEnemyOverlap(int playerIndex, const Player& player, const Enemy& enemy, const CollisionMask* enemyMask)
     {
-        Player* player = GetPlayer();
-        if (!player)
-            return;
+        const CollisionMask* playerMask = GetCollisionMask(playerIndex == 0 ? SPRITE_PLAYER : SPRITE_PLAYER2);
+        if (!playerMask || !enemyMask)
+            return true;
+        return IsMaskMaskCollision(*playerMask, player.position, *enemyMask, enemy.position);
+    }
+
+    bool IsEnemyBulletOverlap(const Enemy& enemy, const CollisionMask* enemyMask, Circle bullet)
+    {
+        if (!enemyMask)
+            return true;
+        return IsMaskCircleCollision(*enemyMask, enemy.position, bullet);
+    }
 
-        // 将玩家转换为矩形用于碰撞检测
-        Rect playerRect = CreateRect(player->position, player->width, player->height);
-        auto& enemies = GetEnemies();
+    bool IsPlayerBulletOverlap(int playerIndex, const Player& player, Circle bullet)
+    {
+        const CollisionMask* playerMask = GetCollisionMask(playerIndex == 0 ? SPRITE_PLAYER : SPRITE_PLAYER2);
+        if (!playerMask)
+            return true;
+        return IsMaskCircleCollision(*playerMask, player.position, bullet);
+    }
+
+    Vector2 EnemyCenter(const Enemy& enemy)
+    {
+        return {enemy.position.x + enemy.width / 2.0, enemy.position.y + enemy.height / 2.0};
+    }
+
+    // 玩家与目标相撞：玩家扣 1 点生命并获得目标的分数（分发时生效）
+    void EmitCrash(int playerIndex, GameEventTarget target, const Attribute& attributes, Vector2 center)
+    {
+        GameEvent event = {};
+        event.type = GAME_EVENT_PLAYER_DAMAGED;
+        event.target = target;
+        event.player = playerIndex;
+        event.damage = 1;
+        event.score = attributes.score;
+        event.position = center;
+        GameEventEmit(event);
+    }
+
+    // 子弹命中目标：立即扣血（同一 tick 后面的子弹要看到结果），记下子弹已用掉，
+    // 产生 HIT 事件，击毁时再产生 KILL 事件。返回目标是否被击毁（由调用者标记目标）
+    bool HitTarget(Attribute& attributes, GameEventTarget target, Vector2 center, size_t bulletIndex,
+                   Vector2 bulletPosition)
+    {
+        const Bullet& bullet = GetBullets()[bulletIndex];
+        attributes.health -= bullet.damage;
+        g_bulletSpent[bulletIndex] = 1;
 
-        // 遍历所有敌人，检查是否与玩家碰撞
-        for (size_t i = 0; i < enemies.size();)
+        GameEvent event = {};
+        event.type = GAME_EVENT_HIT;
+        event.target = target;
+        event.player = bullet.owner;
+        event.damage = bullet.damage;
+        event.lethal = attributes.health <= 0;
+        event.position = bulletPosition;
+        GameEventEmit(event);
+        if (!event.lethal)
+            return false;
+
+        event.type = GAME_EVENT_KILL;
+        event.score = attributes.score;
+        event.position = center;
+        GameEventEmit(event);
+        return true;
+    }
+
+    // 检测玩家与敌人的碰撞（对每一个玩家分别检测），撞上的敌人生命清零，分发之后移除
+    void CheckCollision_Player_Enemies()
+    {
+        for (int pi = 0; pi < GetPlayerCount(); ++pi)
         {
-            Rect enemyRect = CreateRect(enemies[i].position, enemies[i].width, enemies[i].height);
-            
-            if (IsRectRectCollision(playerRect, enemyRect))
+            Player* player = GetPlayerByIndex(pi);
+
+            // 将玩家转换为矩形用于碰撞检测
+            Rect playerRect = CreateRect(player->position, player->width, player->height);
+
+            // 遍历各类型的所有敌人，检查是否与玩家碰撞（已被摧毁的敌人跳过）
+            for (int type = 0; type < ENEMY_TYPE_COUNT; ++type)
             {
-                // 玩家受伤
-                player->attributes.health -= 1;
-                // 玩家获得分数（即使碰撞也得分？这里的逻辑是获得敌人分数）
-                player->attributes.score += enemies[i].attributes.score;
-                // 敌人被消灭
-                enemies.erase(enemies.begin() + static_cast<int>(i));
-
-                // 如果玩家生命值 <= 0，游戏重置
-                if (player->attributes.health <= 0)
+                const CollisionMask* enemyMask = GetCollisionMask(GetEnemySprite(static_cast<EnemyType>(type)));
+                for (Enemy& enemy : GetEnemyBatch(static_cast<EnemyType>(type)))
                 {
-                    ResetGame();
-                    return;
+                    if (enemy.attributes.health <= 0)
+                        continue;
+                    Rect enemyRect = CreateRect(enemy.position, enemy.width, enemy.height);
+                    if (IsRectRectCollision(playerRect, enemyRect) && IsPlayerEnemyOverlap(pi, *player, enemy, enemyMask))
+                    {
+                        EmitCrash(pi, GAME_EVENT_TARGET_ENEMY, enemy.attributes, EnemyCenter(enemy));
+                        enemy.attributes.health = 0;
+                    }
                 }
-                continue;  // 继续检测下一个敌人
             }
-            i++;
         }
     }
 
-    // 检测子弹与敌人的碰撞
-    void CheckCollision_Bullets_Enemies()
+    // 检测玩家与 Boss 部件的碰撞：与敌机相同，撞上的部件被摧毁（每个 Boss 每 tick 至多一个）
+    void CheckCollision_Player_Bosses()
     {
-        Player* player = GetPlayer();
-        if (!player)
-            return;
+        auto& bosses = GetBosses();
+
+        for (int pi = 0; pi < GetPlayerCount(); ++pi)
+        {
+            Player* player = GetPlayerByIndex(pi);
+            Rect playerRect = CreateRect(player->position, player->width, player->height);
+
+            for (Boss& boss : bosses)
+            {
+                if (boss.destroyed)
+                    continue;
+                int part = FindBossPartOverlap(boss, playerRect);
+                if (part < 0)
+                    continue;
+
+                const BossPart& hit = boss.parts[part];
+                EmitCrash(pi, hit.kind == BOSS_PART_CORE ? GAME_EVENT_TARGET_BOSS_CORE : GAME_EVENT_TARGET_BOSS_PART,
+                          hit.attributes, GetBossPartCenter(hit));
+                DestroyBossPart(boss, part);
+            }
+        }
+    }
 
+    // 敌机子弹与玩家的碰撞：玩家扣子弹的伤害（不得分），子弹用掉
+    void CheckEnemyBulletHit(size_t bulletIndex, Vector2 bulletPosition, Circle bulletCircle)
+    {
+        for (int pi = 0; pi < GetPlayerCount(); ++pi)
+        {
+            const Player* player = GetPlayerByIndex(pi);
+            if (!IsRectCircleCollision(CreateRect(player->position, player->width, player->height), bulletCircle) ||
+                !IsPlayerBulletOverlap(pi, *player, bulletCircle))
+                continue;
+
+            GameEvent event = {};
+            event.type = GAME_EVENT_PLAYER_DAMAGED;
+            event.target = GAME_EVENT_TARGET_ENEMY_BULLET;
+            event.player = pi;
+            event.damage = GetBullets()[bulletIndex].damage;
+            event.position = bulletPosition;
+            GameEventEmit(event);
+            g_bulletSpent[bulletIndex] = 1;
+            return;  // 一颗子弹只能击中一个玩家
+        }
+    }
+
+    // 检测子弹与敌人的碰撞（敌机子弹在同一次遍历中改为与玩家检测）
+    void CheckCollision_Bullets_Enemies()
+    {
         auto& bullets = GetBullets();
-        auto& enemies = GetEnemies();
+        // 只遍历非空的类型数组（没有敌机时子弹循环里不做任何敌机检测）
+        std::vector<Enemy>* batches[ENEMY_TYPE_COUNT];
+        const CollisionMask* masks[ENEMY_TYPE_COUNT];
+        int batchCount = 0;
+        for (int type = 0; type < ENEMY_TYPE_COUNT; ++type)
+        {
+            std::vector<Enemy>& batch = GetEnemyBatch(static_cast<EnemyType>(type));
+            if (batch.empty())
+                continue;
+            masks[batchCount] = GetCollisionMask(GetEnemySprite(static_cast<EnemyType>(type)));
+            batches[batchCount++] = &batch;
+        }
 
         // 遍历每一颗子弹
-        for (size_t bi = 0; bi < bullets.size();)
+        for (size_t bi = 0; bi < bullets.size(); ++bi)
         {
             // 将子弹转换为圆形用于碰撞检测
-            Circle bulletCircle = CreateCircle(bullets[bi].position, bullets[bi].radius);
-            bool bulletDestroyed = false;
-
-            // 检查该子弹是否与任何敌人碰撞
-            for (size_t ei = 0; ei < enemies.size(); ++ei)
+            Vector2 bulletPosition = GetBulletPosition(bullets[bi]);
+            Circle bulletCircle = CreateCircle(bulletPosition, bullets[bi].radius);
+            if (bullets[bi].owner < 0)
             {
-                Rect enemyRect = CreateRect(enemies[ei].position, enemies[ei].width, enemies[ei].height);
-                
-                // 如果没有碰撞，继续检查下一个敌人
-                if (!IsRectCircleCollision(enemyRect, bulletCircle))
-                    continue;
+                CheckEnemyBulletHit(bi, bulletPosition, bulletCircle);
+                continue;
+            }
 
-                // 敌人受伤
-                enemies[ei].attributes.health -= bullets[bi].damage;
-                // 如果敌人生命值 <= 0，敌人消灭
-                if (enemies[ei].attributes.health <= 0)
+            // 检查该子弹是否与任何敌人碰撞（已被摧毁的敌人跳过）
+            bool hit = false;
+            for (int b = 0; b < batchCount && !hit; ++b)
+            {
+                for (Enemy& enemy : *batches[b])
                 {
-                    // 玩家得到分数
-                    player->attributes.score += enemies[ei].attributes.score;
-                    enemies.erase(enemies.begin() + static_cast<int>(ei));
+                    if (enemy.attributes.health <= 0)
+                        continue;
+                    Rect enemyRect = CreateRect(enemy.position, enemy.width, enemy.height);
+
+                    // 如果没有碰撞，继续检查下一个敌人
+                    if (!IsRectCircleCollision(enemyRect, bulletCircle) ||
+                        !IsEnemyBulletOverlap(enemy, masks[b], bulletCircle))
+                        continue;
+
+                    // 敌人受伤，生命值 <= 0 时在分发之后被移除
+                    HitTarget(enemy.attributes, GAME_EVENT_TARGET_ENEMY, EnemyCenter(enemy), bi, bulletPosition);
+                    hit = true;
+                    break;  // 一颗子弹只能击中一个敌人
                 }
+            }
+        }
+    }
+
+    // 检测子弹与 Boss 部件的碰撞：先测根包围盒，落在盒内的子弹才向下遍历层次
+    void CheckCollision_Bullets_Bosses()
+    {
+        auto& bosses = GetBosses();
+        if (bosses.empty())
+            return;
+        auto& bullets = GetBullets();
+
+        for (size_t bi = 0; bi < bullets.size(); ++bi)
+        {
+            if (bullets[bi].owner < 0 || g_bulletSpent[bi])
+                continue;
+            Vector2 bulletPosition = GetBulletPosition(bullets[bi]);
+            Circle bulletCircle = CreateCircle(bulletPosition, bullets[bi].radius);
 
-                // 子弹消灭
-                bullets.erase(bullets.begin() + static_cast<int>(bi));
-                bulletDestroyed = true;
-                break;  // 一颗子弹只能击中一个敌人
+            for (Boss& boss : bosses)
+            {
+                if (boss.destroyed)
+                    continue;
+                int part = FindBossPartHit(boss, bulletCircle);
+                if (part < 0)
+                    continue;
+
+                BossPart& hit = boss.parts[part];
+                GameEventTarget target =
+                    hit.kind == BOSS_PART_CORE ? GAME_EVENT_TARGET_BOSS_CORE : GAME_EVENT_TARGET_BOSS_PART;
+                if (HitTarget(hit.attributes, target, GetBossPartCenter(hit), bi, bulletPosition))
+                    DestroyBossPart(boss, part);
+                break;
             }
+        }
+    }
+
+    // 删除本 tick 命中过目标的子弹：从后往前删，把最后一颗移到空位时不会挪动还没处理的下标
+    void RemoveSpentBullets()
+    {
+        for (size_t bi = g_bulletSpent.size(); bi-- > 0;)
+        {
+            if (g_bulletSpent[bi])
+                DestroyBullet(bi);
+        }
+    }
+
+    // ===== 事件处理函数（GameInit 中订阅）=====
+
+    // 计分与生命：击毁目标的分数归发射者；玩家被撞时扣生命并获得目标的分数
+    void OnKillScore(const GameEvent& event)
+    {
+        Player* owner = GetPlayerByIndex(event.player);
+        if (owner)
+            owner->attributes.score += event.score;
+    }
 
-            // 如果子弹还存在，推进到下一颗
-            if (!bulletDestroyed)
-                bi++;
+    void OnPlayerDamaged(const GameEvent& event)
+    {
+        Player* player = GetPlayerByIndex(event.player);
+        if (!player)
+            return;
+        player->attributes.health -= event.damage;
+        player->attributes.score += event.score;
+    }
+
+    // 粒子：未击毁的命中产生火花，击毁和相撞在目标中心爆炸
+    void OnHitSparks(const GameEvent& event)
+    {
+        if (!event.lethal)
+            SpawnHitSparks(event.position.x, event.position.y);
+    }
+
+    void OnExplosion(const GameEvent& event)
+    {
+        // 被敌机子弹击中只有火花
+        if (event.target == GAME_EVENT_TARGET_ENEMY_BULLET)
+            SpawnHitSparks(event.position.x, event.position.y);
+        else
+            SpawnExplosion(event.position.x, event.position.y);
+    }
+
+    // 音效
+    void OnHitSound(const GameEvent& event)
+    {
+        if (!event.lethal)
+            AudioPlay(SOUND_HIT, 0.6f, AudioPanForX(event.position.x));
+    }
+
+    void OnKillSound(const GameEvent& event)
+    {
+        AudioPlay(SOUND_EXPLOSION, 0.8f, AudioPanForX(event.position.x));
+    }
+
+    void OnCrashSound(const GameEvent& event)
+    {
+        // 被敌机子弹击中只是命中音效
+        if (event.target == GAME_EVENT_TARGET_ENEMY_BULLET)
+            AudioPlay(SOUND_HIT, 0.6f, AudioPanForX(event.position.x));
+        else
+            AudioPlay(SOUND_EXPLOSION, 1.0f, AudioPanForX(event.position.x));
+    }
+
+    // 遥测计数
+    void OnTelemetryCount(const GameEvent& event)
+    {
+        switch (event.type)
+        {
+        case GAME_EVENT_HIT:
+            g_tickHits++;
+            break;
+        case GAME_EVENT_KILL:
+            g_tickKills++;
+            break;
+        case GAME_EVENT_PLAYER_DAMAGED:
+            g_tickPlayerHits++;
+            break;
+        default:
+            break;
+        }
+    }
+
+    // 日志：命中、击毁和相撞各记一条（未打开日志时 LogWrite 直接返回）
+    void OnLogEvent(const GameEvent& event)
+    {
+        switch (event.type)
+        {
+        case GAME_EVENT_HIT:
+            LogWrite(LOG_BULLET_HIT, event.player, event.target, event.position.x, event.position.y);
+            break;
+        case GAME_EVENT_KILL:
+            LogWrite(LOG_KILL, event.player, event.target, event.position.x, event.position.y);
+            break;
+        case GAME_EVENT_PLAYER_DAMAGED:
+            if (event.target == GAME_EVENT_TARGET_ENEMY_BULLET)
+                LogWrite(LOG_PLAYER_SHOT, event.player, event.position.x, event.position.y, event.damage);
+            else
+                LogWrite(LOG_PLAYER_DAMAGED, event.player, event.target, event.damage);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void SubscribeEventHandlers()
+    {
+        GameEventReset();
+        GameEventSubscribe(GAME_EVENT_KILL, OnKillScore);
+        GameEventSubscribe(GAME_EVENT_PLAYER_DAMAGED, OnPlayerDamaged);
+        GameEventSubscribe(GAME_EVENT_HIT, OnHitSparks);
+        GameEventSubscribe(GAME_EVENT_KILL, OnExplosion);
+        GameEventSubscribe(GAME_EVENT_PLAYER_DAMAGED, OnExplosion);
+        GameEventSubscribe(GAME_EVENT_HIT, OnHitSound);
+        GameEventSubscribe(GAME_EVENT_KILL, OnKillSound);
+        GameEventSubscribe(GAME_EVENT_PLAYER_DAMAGED, OnCrashSound);
+        GameEventSubscribe(GAME_EVENT_HIT, OnTelemetryCount);
+        GameEventSubscribe(GAME_EVENT_KILL, OnTelemetryCount);
+        GameEventSubscribe(GAME_EVENT_PLAYER_DAMAGED, OnTelemetryCount);
+        GameEventSubscribe(GAME_EVENT_HIT, OnLogEvent);
+        GameEventSubscribe(GAME_EVENT_KILL, OnLogEvent);
+        GameEventSubscribe(GAME_EVENT_PLAYER_DAMAGED, OnLogEvent);
+    }
+
+    // 任一玩家生命耗尽时重置游戏（本 tick 的所有事件都已处理完）
+    bool IsAnyPlayerDead()
+    {
+        for (int pi = 0; pi < GetPlayerCount(); ++pi)
+        {
+            if (GetPlayerByIndex(pi)->attributes.health <= 0)
+                return true;
         }
+        return false;
+    }
+
+    // 把本 tick 的状态追加到遥测
+    void RecordTelemetry(double deltaTime, double updateSeconds)
+    {
+        unsigned int enemiesCreated = GetEnemiesCreated();
+        unsigned int bulletsCreated = GetBulletsCreated();
+        if (!TelemetryIsOpen())
+        {
+            g_lastEnemiesCreated = enemiesCreated;
+            g_lastBulletsCreated = bulletsCreated;
+            return;
+        }
+
+        TelemetryTick tick = {};
+        tick.dtUs = static_cast<int>(deltaTime * 1000000.0);
+        tick.updateUs = static_cast<int>(updateSeconds * 1000000.0);
+        tick.enemies = GetEnemyCount();
+        tick.bullets = static_cast<int>(GetBullets().size());
+        tick.particles = GetParticleCount();
+        tick.enemySpawns = static_cast<int>(enemiesCreated - g_lastEnemiesCreated);
+        tick.shots = static_cast<int>(bulletsCreated - g_lastBulletsCreated);
+        tick.hits = g_tickHits;
+        tick.kills = g_tickKills;
+        tick.playerHits = g_tickPlayerHits;
+        for (int pi = 0; pi < GetPlayerCount() && pi < 2; ++pi)
+        {
+            const Player* player = GetPlayerByIndex(pi);
+            tick.score[pi] = player->attributes.score;
+            tick.health[pi] = player->attributes.health;
+        }
+        tick.governorLevel = static_cast<int>(GetGovernorLevel());
+        TelemetryRecord(tick);
+
+        g_lastEnemiesCreated = enemiesCreated;
+        g_lastBulletsCreated = bulletsCreated;
     }
 }
 
@@ -110,20 +469,83 @@ namespace
 void GameInit()
 {
     HudInit();
+    SpriteAtlasLoad();
+    CollisionMasksBuild();
+    SubscribeEventHandlers();
     ResetGame();
+    g_lastEnemiesCreated = GetEnemiesCreated();
+    g_lastBulletsCreated = GetBulletsCreated();
 }
 
 // 游戏每帧更新
 void GameUpdate(double deltaTime)
 {
+    Uint64 updateStart = SDL_GetPerformanceCounter();
+    LogBeginTick();
+    g_tickHits = 0;
+    g_tickKills = 0;
+    g_tickPlayerHits = 0;
+
+    // 本机玩家的输入来自键盘（联机时远端玩家的输入由网络模块写入）
+    // 带时间戳的按键事件转换为时间线，移动与射击在帧内的真实时刻生效
+    Player* localPlayer = GetPlayer();
+    if (localPlayer && g_inputOverride)
+    {
+        localPlayer->input = g_overrideBits;
+        localPlayer->inputTimeline[0] = {0.0, g_overrideBits};
+        localPlayer->inputSegmentCount = 1;
+    }
+    else if (localPlayer)
+    {
+        localPlayer->input = InputSampleBits();
+        localPlayer->inputSegmentCount = InputGetTimeline(localPlayer->inputTimeline, INPUT_MAX_SEGMENTS);
+    }
+
     // 更新所有实体
-    UpdatePlayer(deltaTime);
-    UpdateEnemies(deltaTime);
-    UpdateBullets(deltaTime);
+    {
+        ALLOC_SCOPE(ALLOC_SCOPE_UPDATE);
+        UpdatePlayer(deltaTime);
+        // 关卡模式：卷轴推进、生成出现点、障碍标记进流场（在敌机寻路之前）
+        LevelUpdate(deltaTime);
+        UpdateEnemies(deltaTime);
+        UpdateBosses(deltaTime);
+        // 目标索引在敌机和 Boss 移动之后重建，导弹和辅助瞄准在 UpdateBullets 中查询
+        SpatialIndexBuild();
+        UpdateBullets(deltaTime);
+        UpdateParticles(deltaTime);
+        BackgroundUpdate(deltaTime);
+    }
+
+    // 检测碰撞：只扣血、标记被摧毁的对象并产生事件
+    {
+        ALLOC_SCOPE(ALLOC_SCOPE_COLLISION);
+        g_bulletSpent.assign(GetBullets().size(), 0);
+        CheckCollision_Player_Enemies();
+        CheckCollision_Player_Bosses();
+        CheckCollision_Bullets_Enemies();
+        CheckCollision_Bullets_Bosses();
+    }
+
+    // 按产生顺序分发事件（计分、粒子、音效、遥测），然后统一移除被摧毁的对象
+    {
+        ALLOC_SCOPE(ALLOC_SCOPE_UPDATE);
+        GameEventDispatch();
+        RemoveSpentBullets();
+        RemoveDestroyedEnemies();
+        RemoveDestroyedBosses();
+        if (IsAnyPlayerDead())
+            ResetGame();
+    }
+
+    double updateSeconds = static_cast<double>(SDL_GetPerformanceCounter() - updateStart) /
+                           static_cast<double>(SDL_GetPerformanceFrequency());
+    RecordTelemetry(deltaTime, updateSeconds);
+}
 
-    // 检测碰撞
-    CheckCollision_Player_Enemies();
-    CheckCollision_Bullets_Enemies();
+void GameSetInputOverride(bool enabled, unsigned int bits)
+{
+    g_inputOverride = enabled;
+    g_overrideBits = bits;
 }
 
 // 游戏每帧渲染
@@ -132,18 +554,93 @@ void GameRender(SDL_Renderer* renderer)
     if (!renderer)
         return;
 
-    // 清空屏幕为白色背景
+    // 清空屏幕为黑色，再叠加视差滚动的星空和云层
     SDL_SetRenderDrawColor(renderer, COLOR_BLACK.r, COLOR_BLACK.g, COLOR_BLACK.b, 255);
     SDL_RenderClear(renderer);
+    {
+        ALLOC_SCOPE(ALLOC_SCOPE_RENDER);
+        BackgroundRender(renderer);
+        LevelRender(renderer);
+    }
 
     // 渲染所有游戏对象
-    RenderPlayer(renderer);
-    RenderEnemies(renderer);
-    RenderBullets(renderer);
+    // 图集可用时三类对象收集到同一个批次，最后一次提交
+    {
+        ALLOC_SCOPE(ALLOC_SCOPE_RENDER);
+        // Boss 由程序绘制的矩形组成，画在其他对象下面
+        RenderBosses(renderer);
+        SpriteBatchBegin(renderer);
+        RenderPlayer(renderer);
+        RenderEnemies(renderer);
+        RenderBullets(renderer);
+        SpriteBatchFlush(renderer);
+        RenderParticles(renderer);
+    }
 
+    ALLOC_SCOPE(ALLOC_SCOPE_HUD);
     Player* player = GetPlayer();
     if (player)
         HudRender(renderer, player->attributes.score);
+
+    // 统计信息逐行显示在得分下方
+    // 文字只在 HUD 刷新帧重新格式化，其余帧沿用缓存
+    static char latencyStats[128];
+    static char loadStats[128];
+    static char netStats[128];
+    static char levelStats[128];
+    static char allocStats[128];
+    static char inputStats[128];
+    bool refresh = !player || HudIsRefreshFrame();
+    int line = 40;
+
+    // 输入到显示的延迟
+    if (refresh)
+        FramePacerFormatStats(latencyStats, sizeof(latencyStats));
+    HudRenderText(renderer, 10, line, latencyStats);
+    line += 30;
+
+    // 帧时间预算与降级等级
+    if (refresh)
+        GovernorFormatStats(loadStats, sizeof(loadStats));
+    HudRenderText(renderer, 10, line, loadStats);
+    line += 30;
+
+    // 联机时显示带宽与延迟统计
+    if (NetGetMode() != NET_MODE_OFFLINE)
+    {
+        if (refresh)
+            NetFormatStats(netStats, sizeof(netStats));
+        HudRenderText(renderer, 10, line, netStats);
+        line += 30;
+    }
+
+    // 关卡进度与流式加载统计
+    if (LevelIsOpen())
+    {
+        if (refresh)
+            LevelFormatStats(levelStats, sizeof(levelStats));
+        HudRenderText(renderer, 10, line, levelStats);
+        line += 30;
+    }
+
+    // 输入事件队列溢出过时显示丢弃的事件数（点按可能丢失）
+    if (InputGetDroppedEventCount() > 0)
+    {
+        if (refresh)
+            std::snprintf(inputStats, sizeof(inputStats), "Input queue overflow: %d events dropped",
+                          InputGetDroppedEventCount());
+        HudRenderText(renderer, 10, line, inputStats);
+        line += 30;
+    }
+
+    // 开启分配统计时显示上一帧各子系统的堆分配
+    if (AllocTrackerIsEnabled())
+    {
+        if (refresh)
+            AllocTrackerFormatStats(allocStats, sizeof(allocStats));
+        HudRenderText(renderer, 10, line, allocStats);
+        line += 30;
+    }
 }
 
 // 游戏清理
@@ -152,5 +649,11 @@ void GameShutdown()
     DestroyPlayer();
     ClearEnemies();
     ClearBullets();
+    ClearParticles();
     HudShutdown();
+    SpriteBatchShutdown();
+    BackgroundShutdown();
+    CollisionMasksClear();
+    SpriteAtlasUnload();
+    GameEventReset();
 }
@@ -10,6 +10,9 @@ void GameInit();
 // 更新游戏状态（所有实体的逻辑更新和碰撞检测）
 void GameUpdate(double deltaTime);
 
+// 用固定的按键位掩码代替键盘驱动本机玩家（自动测试用），enabled = false 时恢复键盘输入
+void GameSetInputOverride(bool enabled, unsigned int bits);
+
 // 渲染游戏画面
 void GameRender(SDL_Renderer* renderer);
 
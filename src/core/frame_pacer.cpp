@@ -0,0 +1,131 @@
+#include "frame_pacer.h"
+
+#include "../util/config.h"
+
+#include <SDL.h>
+#include <cstdio>
+
+namespace
+{
+    bool g_lowLatency = false;
+
+    // 帧率限制器
+    double g_frequency = 1.0;         // 性能计数器频率
+    Uint64 g_frameTicks = 0;          // 每帧的计数器刻度数
+    Uint64 g_nextFrame = 0;           // 下一帧的开始时刻
+
+    // 尚未显示的最早输入事件时间（毫秒），0 表示没有
+    Uint32 g_pendingInputMs = 0;
+    bool g_hasPendingInput = false;
+
+    // 首帧耗时
+    Uint64 g_processStart = 0;
+    double g_firstFrameMs = -1.0;
+
+    // 延迟统计（最近 LATENCY_WINDOW 个样本）
+    double g_samples[LATENCY_WINDOW] = {};
+    int g_sampleCount = 0;
+    int g_sampleNext = 0;
+}
+
+void FramePacerMarkProcessStart()
+{
+    g_processStart = SDL_GetPerformanceCounter();
+}
+
+void FramePacerInit(bool lowLatency, int targetFps)
+{
+    g_lowLatency = lowLatency;
+    g_frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    g_frameTicks = static_cast<Uint64>(g_frequency / (targetFps > 0 ? targetFps : TARGET_FPS));
+    g_nextFrame = SDL_GetPerformanceCounter();
+    g_hasPendingInput = false;
+    g_sampleCount = 0;
+    g_sampleNext = 0;
+}
+
+bool FramePacerIsLowLatency()
+{
+    return g_lowLatency;
+}
+
+void FramePacerWait()
+{
+    if (!g_lowLatency)
+        return;
+
+    g_nextFrame += g_frameTicks;
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    // 落后超过一帧（例如窗口被拖动）时不追帧，直接从现在重新计时
+    if (now > g_nextFrame + g_frameTicks)
+    {
+        g_nextFrame = now;
+        return;
+    }
+
+    // 先用 SDL_Delay 睡到距离目标还剩 PACER_SPIN_MS 时，避免占满 CPU
+    double remainingMs = (static_cast<double>(g_nextFrame) - static_cast<double>(now)) * 1000.0 / g_frequency;
+    if (remainingMs > PACER_SPIN_MS)
+        SDL_Delay(static_cast<Uint32>(remainingMs - PACER_SPIN_MS));
+
+    // 最后一小段自旋等待，补偿系统定时器的粒度
+    while (SDL_GetPerformanceCounter() < g_nextFrame)
+    {
+    }
+}
+
+void FramePacerNoteInput(unsigned int eventTimestampMs)
+{
+    // 一帧内只记录最早的事件：它等待得最久
+    if (!g_hasPendingInput)
+    {
+        g_pendingInputMs = eventTimestampMs;
+        g_hasPendingInput = true;
+    }
+}
+
+void FramePacerPresented()
+{
+    if (g_firstFrameMs < 0.0)
+    {
+        g_firstFrameMs = static_cast<double>(SDL_GetPerformanceCounter() - g_processStart) * 1000.0 /
+                         static_cast<double>(SDL_GetPerformanceFrequency());
+        SDL_Log("Time to first frame: %.1f ms (target < %d ms)", g_firstFrameMs, FIRST_FRAME_TARGET_MS);
+    }
+
+    if (!g_hasPendingInput)
+        return;
+
+    g_samples[g_sampleNext] = static_cast<double>(SDL_GetTicks() - g_pendingInputMs);
+    g_sampleNext = (g_sampleNext + 1) % LATENCY_WINDOW;
+    if (g_sampleCount < LATENCY_WINDOW)
+        g_sampleCount++;
+    g_hasPendingInput = false;
+}
+
+double FramePacerGetFirstFrameMs()
+{
+    return g_firstFrameMs;
+}
+
+void FramePacerFormatStats(char* buffer, int size)
+{
+    const char* mode = g_lowLatency ? "low latency" : "vsync";
+    if (g_sampleCount == 0)
+    {
+        std::snprintf(buffer, size, "Input->Present: -- (%s)  First frame %.1f ms", mode, g_firstFrameMs);
+        return;
+    }
+
+    double sum = 0.0;
+    double worst = 0.0;
+    for (int i = 0; i < g_sampleCount; ++i)
+    {
+        sum += g_samples[i];
+        if (g_samples[i] > worst)
+            worst = g_samples[i];
+    }
+    std::snprintf(buffer, size, "Input->Present: avg %.1f ms  max %.0f ms (%s)  First frame %.1f ms",
+                  sum / g_sampleCount, worst, mode, g_firstFrameMs);
+}
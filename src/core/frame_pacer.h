@@ -0,0 +1,31 @@
+#pragma once
+
+// ===== 帧节奏控制与输入延迟测量 =====
+// 低延迟模式下关闭垂直同步，由"睡眠 + 自旋"的帧率限制器控制节奏，
+// 并在限制器等待结束后才轮询输入，使输入尽量靠近本帧的更新；
+// 两种模式下都会测量"输入事件时间戳 → 画面提交"的延迟
+
+// 记录进程启动时刻（main 的第一行调用），用于测量首帧耗时
+void FramePacerMarkProcessStart();
+
+// 初始化帧节奏控制（lowLatency = false 时依赖垂直同步，不做限帧）
+void FramePacerInit(bool lowLatency, int targetFps);
+
+// 是否处于低延迟模式
+bool FramePacerIsLowLatency();
+
+// 低延迟模式：等待到下一帧的开始时刻（先睡眠，最后一小段自旋）
+void FramePacerWait();
+
+// 记录一个尚未显示的输入事件（SDL 事件时间戳，毫秒）
+void FramePacerNoteInput(unsigned int eventTimestampMs);
+
+// 在 SDL_RenderPresent 之后调用，结算本帧内输入的延迟
+// 第一次调用时同时记录并输出首帧耗时
+void FramePacerPresented();
+
+// 从进程启动到第一帧提交的耗时（毫秒），尚未提交时返回负数
+double FramePacerGetFirstFrameMs();
+
+// 把延迟统计格式化为一行文字（供 HUD 显示）
+void FramePacerFormatStats(char* buffer, int size);
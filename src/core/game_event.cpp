@@ -0,0 +1,58 @@
+#include "game_event.h"
+
+#include "../util/config.h"
+
+#include <SDL.h>
+#include <vector>
+
+namespace
+{
+    GameEventHandler g_handlers[GAME_EVENT_TYPE_COUNT][GAME_EVENT_MAX_HANDLERS] = {};
+    int g_handlerCounts[GAME_EVENT_TYPE_COUNT] = {};
+
+    // 本 tick 的事件（清空时保留容量，稳定运行后不再分配）
+    std::vector<GameEvent> g_events;
+}
+
+void GameEventSubscribe(GameEventType type, GameEventHandler handler)
+{
+    if (type < 0 || type >= GAME_EVENT_TYPE_COUNT || !handler)
+        return;
+    if (g_handlerCounts[type] >= GAME_EVENT_MAX_HANDLERS)
+    {
+        SDL_Log("GameEventSubscribe: too many handlers for event type %d", static_cast<int>(type));
+        return;
+    }
+    g_handlers[type][g_handlerCounts[type]++] = handler;
+}
+
+void GameEventReset()
+{
+    for (int type = 0; type < GAME_EVENT_TYPE_COUNT; ++type)
+        g_handlerCounts[type] = 0;
+    g_events.clear();
+}
+
+void GameEventEmit(const GameEvent& event)
+{
+    if (g_events.capacity() == 0)
+        g_events.reserve(GAME_EVENT_RESERVE);
+    g_events.push_back(event);
+}
+
+void GameEventDispatch()
+{
+    // 按下标遍历：处理函数追加的事件可能让数组重新分配，每次先复制出当前事件
+    for (size_t i = 0; i < g_events.size(); ++i)
+    {
+        GameEvent event = g_events[i];
+        for (int h = 0; h < g_handlerCounts[event.type]; ++h)
+            g_handlers[event.type][h](event);
+    }
+    g_events.clear();
+}
+
+int GetPendingGameEventCount()
+{
+    return static_cast<int>(g_events.size());
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../util/type.h"
+
+// ===== 游戏事件 =====
+// 碰撞检测只判断命中、扣除目标生命并标记被摧毁的目标，把结果写成事件追加到本 tick 的数组里；
+// 之后统一的分发阶段按产生顺序把每个事件交给订阅了该类型的处理函数（计分、粒子、音效、遥测），
+// 被摧毁的对象在分发之后一次性移除，检测循环中不再边遍历边删除。
+// 事件是不含指针的 POD，各个检测阶段将来可以各写各的数组、按阶段顺序拼接后再分发
+
+// 事件类型
+enum GameEventType
+{
+    GAME_EVENT_HIT = 0,         // 子弹命中目标（包括致命的一击）
+    GAME_EVENT_KILL,            // 目标被子弹摧毁
+    GAME_EVENT_PLAYER_DAMAGED,  // 玩家撞上敌机或 Boss 部件，或被敌机子弹击中
+    GAME_EVENT_TYPE_COUNT
+};
+
+// 事件目标
+enum GameEventTarget
+{
+    GAME_EVENT_TARGET_ENEMY = 0,
+    GAME_EVENT_TARGET_BOSS_PART,
+    GAME_EVENT_TARGET_BOSS_CORE,    // 核心被摧毁意味着整个 Boss 被消灭
+    GAME_EVENT_TARGET_ENEMY_BULLET  // 射手的子弹（只出现在 PLAYER_DAMAGED 中）
+};
+
+struct GameEvent
+{
+    GameEventType type;
+    GameEventTarget target;
+    int player;         // HIT/KILL：发射子弹的玩家；PLAYER_DAMAGED：被撞的玩家
+    int damage;         // HIT：子弹伤害；PLAYER_DAMAGED：玩家损失的生命
+    int score;          // KILL/PLAYER_DAMAGED：目标的分数
+    bool lethal;        // HIT：这一击摧毁了目标（随后紧跟一个 KILL）
+    Vector2 position;   // HIT：命中点；KILL/PLAYER_DAMAGED：目标中心（被子弹击中时为命中点）
+};
+
+typedef void (*GameEventHandler)(const GameEvent& event);
+
+// 订阅某一类事件（同一类型的处理函数按订阅顺序调用，每类最多 GAME_EVENT_MAX_HANDLERS 个）
+void GameEventSubscribe(GameEventType type, GameEventHandler handler);
+
+// 取消所有订阅并清空事件（GameShutdown 时调用）
+void GameEventReset();
+
+// 追加一个事件（不立即处理）
+void GameEventEmit(const GameEvent& event);
+
+// 按产生顺序分发本 tick 的所有事件后清空；处理函数中产生的新事件排在后面，同一次分发中处理
+void GameEventDispatch();
+
+// 本 tick 尚未分发的事件数量
+int GetPendingGameEventCount();
@@ -0,0 +1,149 @@
+#include "governor.h"
+
+#include "../game_object/bullet.h"
+#include "../game_object/enemy.h"
+#include "../game_object/particle.h"
+#include "../render/background.h"
+#include "../render/sprite_atlas.h"
+#include "../ui/hud.h"
+#include "../util/config.h"
+#include "../util/log.h"
+
+#include <SDL.h>
+#include <cstdio>
+
+namespace
+{
+    GovernorLevel g_level = GOVERNOR_LEVEL_FULL;
+    int g_levelChanges = 0;
+
+    double g_budgetMs = 1000.0 / TARGET_FPS;  // 单帧工作时间预算
+    double g_frequency = 1.0;
+    Uint64 g_frameStart = 0;
+
+    // 当前统计窗口
+    double g_windowTotalMs = 0.0;
+    int g_windowFrames = 0;
+    double g_lastAverageMs = 0.0;
+    int g_headroomWindows = 0;  // 连续有余量的窗口数
+
+    // 按等级设置各模块的开关（每一级包含之前所有级别）
+    void ApplyLevel(GovernorLevel level)
+    {
+        SetParticleBudget(level >= GOVERNOR_LEVEL_PARTICLES ? GOVERNOR_PARTICLE_BUDGET : PARTICLE_BUDGET);
+        SetBackgroundLayerCount(level >= GOVERNOR_LEVEL_PARTICLES ? GOVERNOR_BACKGROUND_LAYERS : BACKGROUND_LAYERS);
+        SetBulletCircleStep(level >= GOVERNOR_LEVEL_CIRCLES ? GOVERNOR_CIRCLE_STEP : 1);
+        HudSetRefreshInterval(level >= GOVERNOR_LEVEL_HUD ? GOVERNOR_HUD_INTERVAL : 1);
+        SetMaxEnemies(level >= GOVERNOR_LEVEL_ENTITIES ? GOVERNOR_MAX_ENEMIES : 0);
+        SetMaxBullets(level >= GOVERNOR_LEVEL_ENTITIES ? GOVERNOR_MAX_BULLETS : 0);
+    }
+
+    // 图集已加载时子弹走精灵批次，不再绘制圆形，"降低圆形绘制质量"这一级没有效果
+    bool HasEffect(GovernorLevel level)
+    {
+        return level != GOVERNOR_LEVEL_CIRCLES || !SpriteAtlasIsLoaded();
+    }
+
+    // 向 direction（+1 降级 / -1 恢复）方向的下一个有效果的等级
+    GovernorLevel StepLevel(GovernorLevel level, int direction)
+    {
+        int next = level + direction;
+        while (next > GOVERNOR_LEVEL_FULL && next < GOVERNOR_LEVEL_COUNT - 1 &&
+               !HasEffect(static_cast<GovernorLevel>(next)))
+            next += direction;
+        return static_cast<GovernorLevel>(next);
+    }
+
+    void ChangeLevel(GovernorLevel level)
+    {
+        SDL_Log("Governor: %s -> %s (avg work %.2f ms, budget %.2f ms)",
+                GetGovernorLevelName(g_level), GetGovernorLevelName(level), g_lastAverageMs, g_budgetMs);
+        LogWrite(LOG_GOVERNOR_LEVEL, g_level, level);
+        g_level = level;
+        g_levelChanges++;
+        g_headroomWindows = 0;
+        ApplyLevel(level);
+    }
+}
+
+void GovernorInit(int targetFps)
+{
+    g_budgetMs = 1000.0 / (targetFps > 0 ? targetFps : TARGET_FPS);
+    g_frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    g_level = GOVERNOR_LEVEL_FULL;
+    g_levelChanges = 0;
+    g_windowTotalMs = 0.0;
+    g_windowFrames = 0;
+    g_lastAverageMs = 0.0;
+    g_headroomWindows = 0;
+    ApplyLevel(g_level);
+}
+
+void GovernorBeginFrame()
+{
+    g_frameStart = SDL_GetPerformanceCounter();
+}
+
+void GovernorEndFrame()
+{
+    double workMs = static_cast<double>(SDL_GetPerformanceCounter() - g_frameStart) * 1000.0 / g_frequency;
+    if (workMs > g_budgetMs)
+        LogWrite(LOG_FRAME_OVERRUN, workMs, g_budgetMs);
+    g_windowTotalMs += workMs;
+    if (++g_windowFrames < GOVERNOR_WINDOW)
+        return;
+
+    // 一个窗口结束：按平均工作时间决定升降级
+    g_lastAverageMs = g_windowTotalMs / g_windowFrames;
+    g_windowTotalMs = 0.0;
+    g_windowFrames = 0;
+
+    if (g_lastAverageMs > g_budgetMs * GOVERNOR_HIGH_RATIO)
+    {
+        g_headroomWindows = 0;
+        if (g_level + 1 < GOVERNOR_LEVEL_COUNT)
+            ChangeLevel(StepLevel(g_level, 1));
+    }
+    else if (g_lastAverageMs < g_budgetMs * GOVERNOR_LOW_RATIO)
+    {
+        if (g_level > GOVERNOR_LEVEL_FULL && ++g_headroomWindows >= GOVERNOR_RECOVER_WINDOWS)
+            ChangeLevel(StepLevel(g_level, -1));
+    }
+    else
+        g_headroomWindows = 0;
+}
+
+GovernorLevel GetGovernorLevel()
+{
+    return g_level;
+}
+
+const char* GetGovernorLevelName(GovernorLevel level)
+{
+    switch (level)
+    {
+    case GOVERNOR_LEVEL_FULL: return "full";
+    case GOVERNOR_LEVEL_PARTICLES: return "particles";
+    case GOVERNOR_LEVEL_CIRCLES: return "circles";
+    case GOVERNOR_LEVEL_HUD: return "hud";
+    case GOVERNOR_LEVEL_ENTITIES: return "entities";
+    default: return "?";
+    }
+}
+
+int GetGovernorLevelChanges()
+{
+    return g_levelChanges;
+}
+
+double GetGovernorAverageWorkMs()
+{
+    return g_lastAverageMs;
+}
+
+void GovernorFormatStats(char* buffer, int size)
+{
+    std::snprintf(buffer, size, "Load L%d %s  work %.1f/%.1f ms  changes %d",
+                  static_cast<int>(g_level), GetGovernorLevelName(g_level), g_lastAverageMs, g_budgetMs,
+                  g_levelChanges);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// ===== 帧时间预算调节器 =====
+// 统计每帧的工作时间（不含等待垂直同步和限帧睡眠），与 1000 / 目标帧率 的预算比较；
+// 超出预算时按固定顺序逐级关闭可选的工作，有余量时再逐级恢复
+
+// 降级等级：每一级都包含之前所有级别的降级
+enum GovernorLevel
+{
+    GOVERNOR_LEVEL_FULL = 0,     // 全部效果
+    GOVERNOR_LEVEL_PARTICLES,    // 降低粒子密度，减少背景层数
+    GOVERNOR_LEVEL_CIRCLES,      // 降低圆形绘制质量（图集已加载时没有效果，升降级时跳过）
+    GOVERNOR_LEVEL_HUD,          // 降低 HUD 刷新频率
+    GOVERNOR_LEVEL_ENTITIES,     // 限制同时存在的敌机和子弹数量
+    GOVERNOR_LEVEL_COUNT
+};
+
+// 初始化调节器（恢复到全部效果）
+void GovernorInit(int targetFps);
+
+// 一帧工作开始（限帧等待之后）
+void GovernorBeginFrame();
+
+// 一帧工作结束（提交画面之前），每满一个统计窗口决定是否调整等级
+void GovernorEndFrame();
+
+// 当前降级等级
+GovernorLevel GetGovernorLevel();
+
+// 等级名称（用于日志和 HUD）
+const char* GetGovernorLevelName(GovernorLevel level);
+
+// 等级变化的累计次数
+int GetGovernorLevelChanges();
+
+// 最近一个统计窗口的平均工作时间（毫秒）
+double GetGovernorAverageWorkMs();
+
+// 把当前等级和工作时间格式化为一行文字（供 HUD 显示）
+void GovernorFormatStats(char* buffer, int size);
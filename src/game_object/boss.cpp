@@ -0,0 +1,389 @@
+#include "boss.h"
+
+#include "particle.h"
+
+#include "../util/util.h"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    static_assert(BOSS_MAX_PARTS <= 64, "Boss part masks are 64-bit");
+
+    const int kColumns = 9;
+    const int kRows = 5;
+    const double kPi = 3.14159265358979323846;
+
+    // 所有当前存在的 Boss
+    std::vector<Boss> g_bosses;
+    // 出现计时器（场上有 Boss 时暂停）
+    double g_spawnTimer = 0.0;
+    // 下一个 Boss 的编号
+    unsigned int g_nextBossId = 1;
+    // 是否定时出现
+    bool g_autoSpawn = true;
+
+    // 绘制缓冲：每种部件攒成一批再提交
+    SDL_Rect g_drawRects[3][BOSS_MAX_PARTS * BOSS_MAX_COUNT];
+
+    Rect UnionRect(Rect a, Rect b)
+    {
+        return {std::min(a.left, b.left), std::max(a.right, b.right), std::min(a.top, b.top),
+                std::max(a.bottom, b.bottom)};
+    }
+
+    void AddPart(Boss& boss, int column, int row, int columns, int rows, int kind)
+    {
+        BossPart& part = boss.parts[boss.partCount++];
+        // 格子之间留 2 像素缝隙
+        part.offset = {column * BOSS_CELL_WIDTH + 1.0, row * BOSS_CELL_HEIGHT + 1.0};
+        part.width = columns * BOSS_CELL_WIDTH - 2.0;
+        part.height = rows * BOSS_CELL_HEIGHT - 2.0;
+        part.kind = kind;
+        part.alive = true;
+        part.attributes = {};
+        if (kind == BOSS_PART_CORE)
+        {
+            part.attributes.health = BOSS_CORE_HEALTH;
+            part.attributes.score = BOSS_CORE_SCORE;
+        }
+        else if (kind == BOSS_PART_TURRET)
+        {
+            part.attributes.health = BOSS_TURRET_HEALTH;
+            part.attributes.score = BOSS_TURRET_SCORE;
+        }
+        else
+        {
+            part.attributes.health = BOSS_ARMOR_HEALTH;
+            part.attributes.score = BOSS_ARMOR_SCORE;
+        }
+    }
+
+    // 部件中心在 Boss 局部坐标中的位置（建树用，与 Boss 的位置无关）
+    Vector2 LocalCenter(const BossPart& part)
+    {
+        return {part.offset.x + part.width / 2.0, part.offset.y + part.height / 2.0};
+    }
+
+    // 固定布局：中央 3×2 格的核心，底排和顶排两角是炮塔，其余格子是装甲板（共 40 个部件）
+    void BuildLayout(Boss& boss)
+    {
+        boss.partCount = 0;
+        AddPart(boss, 3, 1, 3, 2, BOSS_PART_CORE);
+        for (int row = 0; row < kRows; ++row)
+        {
+            for (int column = 0; column < kColumns; ++column)
+            {
+                if (row >= 1 && row <= 2 && column >= 3 && column <= 5)
+                    continue;
+                bool turret = (row == kRows - 1 && column % 2 == 0) ||
+                              (row == 0 && (column == 0 || column == kColumns - 1));
+                AddPart(boss, column, row, 1, 1, turret ? BOSS_PART_TURRET : BOSS_PART_ARMOR);
+            }
+        }
+        boss.liveParts = boss.partCount;
+    }
+
+    // 自顶向下建树：按部件中心在较长轴上的中位数划分，部件数组被重排成叶子区间连续
+    int BuildNode(Boss& boss, int first, int count)
+    {
+        int index = boss.nodeCount++;
+        BossBvhNode& node = boss.nodes[index];
+        node.first = first;
+        node.count = count;
+        node.left = node.right = -1;
+        node.empty = false;
+        if (count <= BOSS_BVH_LEAF_PARTS)
+            return index;
+
+        Rect centers = {1e30, -1e30, 1e30, -1e30};
+        for (int i = first; i < first + count; ++i)
+        {
+            Vector2 c = LocalCenter(boss.parts[i]);
+            centers = UnionRect(centers, {c.x, c.x, c.y, c.y});
+        }
+        bool splitX = centers.right - centers.left >= centers.bottom - centers.top;
+        int half = count / 2;
+        std::nth_element(boss.parts + first, boss.parts + first + half, boss.parts + first + count,
+                         [splitX](const BossPart& a, const BossPart& b) {
+                             return splitX ? LocalCenter(a).x < LocalCenter(b).x : LocalCenter(a).y < LocalCenter(b).y;
+                         });
+
+        node.count = 0;
+        node.left = BuildNode(boss, first, half);
+        node.right = BuildNode(boss, first + half, count - half);
+        return index;
+    }
+
+    // 每个 tick 的移动：先下降入场，到达停留高度后左右正弦摆动
+    void MoveBoss(Boss& boss, double deltaTime)
+    {
+        boss.age += deltaTime;
+        if (boss.position.y < BOSS_HOVER_Y)
+        {
+            boss.position.y = std::min(BOSS_HOVER_Y, boss.position.y + BOSS_DESCENT_SPEED * deltaTime);
+            return;
+        }
+        double centerX = (GAME_WIDTH - boss.width) / 2.0;
+        double sway = std::sin(boss.age * 2.0 * kPi / BOSS_SWAY_PERIOD) * BOSS_SWAY_AMPLITUDE;
+        // 从入场位置平滑过渡到摆动轨迹
+        double target = Clamp(centerX + sway, 0.0, GAME_WIDTH - boss.width);
+        boss.position.x += (target - boss.position.x) * std::min(1.0, deltaTime * 2.0);
+    }
+
+    // 节点只和查询形状的包围盒比较（矩形相交比圆与矩形的精确检测便宜），部件用精确检测
+    template <typename Overlaps>
+    int FindPart(const Boss& boss, Rect query, Overlaps overlaps)
+    {
+        if (boss.nodeCount == 0 || boss.nodes[0].empty || !IsRectRectCollision(boss.nodes[0].bounds, query))
+            return -1;
+
+        int stack[BOSS_MAX_PARTS];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const BossBvhNode& node = boss.nodes[stack[--top]];
+            if (node.count > 0)
+            {
+                for (int i = node.first; i < node.first + node.count; ++i)
+                {
+                    if (boss.parts[i].alive && overlaps(boss.parts[i].bounds))
+                        return i;
+                }
+                continue;
+            }
+            const BossBvhNode& left = boss.nodes[node.left];
+            const BossBvhNode& right = boss.nodes[node.right];
+            if (!right.empty && IsRectRectCollision(right.bounds, query))
+                stack[top++] = node.right;
+            if (!left.empty && IsRectRectCollision(left.bounds, query))
+                stack[top++] = node.left;
+        }
+        return -1;
+    }
+
+    // 初始化一个 Boss：固定布局、建树一次并按位置计算包围盒
+    void InitBoss(Boss& boss, unsigned int id, double x, double y)
+    {
+        boss.position = {x, y};
+        boss.width = kColumns * BOSS_CELL_WIDTH;
+        boss.height = kRows * BOSS_CELL_HEIGHT;
+        boss.age = 0.0;
+        boss.id = id;
+        boss.destroyed = false;
+        BuildLayout(boss);
+        boss.nodeCount = 0;
+        BuildNode(boss, 0, boss.partCount);
+        RefitBoss(boss);
+    }
+}
+
+Boss* CreateBoss(double x, double y)
+{
+    if (static_cast<int>(g_bosses.size()) >= BOSS_MAX_COUNT)
+        return nullptr;
+
+    g_bosses.emplace_back();
+    Boss& boss = g_bosses.back();
+    InitBoss(boss, g_nextBossId++, x, y);
+    return &boss;
+}
+
+void SetBossReplica(int index, unsigned int id, double x, double y, unsigned long long partMask)
+{
+    if (index < 0 || index >= BOSS_MAX_COUNT)
+        return;
+    if (index >= static_cast<int>(g_bosses.size()))
+        g_bosses.resize(index + 1);
+
+    Boss& boss = g_bosses[index];
+    if (boss.id != id || boss.partCount == 0)
+        InitBoss(boss, id, x, y);
+    boss.position = {x, y};
+    SetBossPartMask(boss, partMask);
+}
+
+void TruncateBossReplicas(int count)
+{
+    if (count >= 0 && count < static_cast<int>(g_bosses.size()))
+        g_bosses.resize(count);
+}
+
+void RefitBoss(Boss& boss)
+{
+    for (int i = 0; i < boss.partCount; ++i)
+    {
+        BossPart& part = boss.parts[i];
+        part.bounds = CreateRect({boss.position.x + part.offset.x, boss.position.y + part.offset.y}, part.width,
+                                 part.height);
+    }
+
+    // 逆序：子节点先于父节点更新；被摧毁的部件不计入包围盒
+    for (int n = boss.nodeCount - 1; n >= 0; --n)
+    {
+        BossBvhNode& node = boss.nodes[n];
+        node.empty = true;
+        if (node.count > 0)
+        {
+            for (int i = node.first; i < node.first + node.count; ++i)
+            {
+                if (!boss.parts[i].alive)
+                    continue;
+                node.bounds = node.empty ? boss.parts[i].bounds : UnionRect(node.bounds, boss.parts[i].bounds);
+                node.empty = false;
+            }
+            continue;
+        }
+        const BossBvhNode& left = boss.nodes[node.left];
+        const BossBvhNode& right = boss.nodes[node.right];
+        if (!left.empty && !right.empty)
+            node.bounds = UnionRect(left.bounds, right.bounds);
+        else if (!left.empty || !right.empty)
+            node.bounds = left.empty ? right.bounds : left.bounds;
+        node.empty = left.empty && right.empty;
+    }
+}
+
+void UpdateBosses(double deltaTime)
+{
+    // 场上没有 Boss 时计时，到时间在屏幕上方正中出现一个
+    if (g_bosses.empty() && g_autoSpawn)
+    {
+        g_spawnTimer += deltaTime;
+        if (g_spawnTimer >= BOSS_SPAWN_INTERVAL)
+        {
+            g_spawnTimer = 0.0;
+            CreateBoss((GAME_WIDTH - kColumns * BOSS_CELL_WIDTH) / 2.0, -kRows * BOSS_CELL_HEIGHT);
+        }
+    }
+
+    for (Boss& boss : g_bosses)
+    {
+        MoveBoss(boss, deltaTime);
+        RefitBoss(boss);
+    }
+}
+
+void RenderBosses(SDL_Renderer* renderer)
+{
+    if (!renderer || g_bosses.empty())
+        return;
+
+    int counts[3] = {0, 0, 0};
+    for (const Boss& boss : g_bosses)
+    {
+        for (int i = 0; i < boss.partCount; ++i)
+        {
+            const BossPart& part = boss.parts[i];
+            if (!part.alive)
+                continue;
+            SDL_Rect& r = g_drawRects[part.kind][counts[part.kind]++];
+            r.x = static_cast<int>(boss.position.x + part.offset.x);
+            r.y = static_cast<int>(boss.position.y + part.offset.y);
+            r.w = static_cast<int>(part.width);
+            r.h = static_cast<int>(part.height);
+        }
+    }
+
+    // 核心金黄、炮塔橙色、装甲灰色
+    static const Uint8 kColors[3][3] = {{250, 200, 40}, {230, 120, 40}, {130, 130, 140}};
+    for (int kind = 0; kind < 3; ++kind)
+    {
+        if (counts[kind] == 0)
+            continue;
+        SDL_SetRenderDrawColor(renderer, kColors[kind][0], kColors[kind][1], kColors[kind][2], 255);
+        SDL_RenderFillRects(renderer, g_drawRects[kind], counts[kind]);
+    }
+}
+
+void ClearBosses()
+{
+    g_bosses.clear();
+    g_bosses.reserve(BOSS_MAX_COUNT);
+    g_spawnTimer = 0.0;
+}
+
+void SetBossAutoSpawn(bool enabled)
+{
+    g_autoSpawn = enabled;
+    g_spawnTimer = 0.0;
+}
+
+std::vector<Boss>& GetBosses()
+{
+    return g_bosses;
+}
+
+int FindBossPartHit(const Boss& boss, Circle circle)
+{
+    Rect query = {circle.center.x - circle.radius, circle.center.x + circle.radius, circle.center.y - circle.radius,
+                  circle.center.y + circle.radius};
+    return FindPart(boss, query, [circle](Rect r) { return IsRectCircleCollision(r, circle); });
+}
+
+int FindBossPartOverlap(const Boss& boss, Rect rect)
+{
+    return FindPart(boss, rect, [rect](Rect r) { return IsRectRectCollision(r, rect); });
+}
+
+void DestroyBossPart(Boss& boss, int part)
+{
+    if (part < 0 || part >= boss.partCount || !boss.parts[part].alive)
+        return;
+    boss.parts[part].alive = false;
+    boss.liveParts--;
+    if (boss.parts[part].kind == BOSS_PART_CORE)
+        boss.destroyed = true;
+}
+
+void RemoveDestroyedBosses()
+{
+    for (size_t b = 0; b < g_bosses.size();)
+    {
+        Boss& boss = g_bosses[b];
+        if (!boss.destroyed)
+        {
+            b++;
+            continue;
+        }
+        for (int i = 0; i < boss.partCount; ++i)
+        {
+            if (!boss.parts[i].alive)
+                continue;
+            Vector2 center = GetBossPartCenter(boss.parts[i]);
+            SpawnExplosion(center.x, center.y);
+        }
+        g_bosses.erase(g_bosses.begin() + static_cast<long>(b));
+    }
+}
+
+Vector2 GetBossPartCenter(const BossPart& part)
+{
+    return {part.bounds.left + part.width / 2.0, part.bounds.top + part.height / 2.0};
+}
+
+unsigned long long GetBossPartMask(const Boss& boss)
+{
+    unsigned long long mask = 0;
+    for (int i = 0; i < boss.partCount; ++i)
+    {
+        if (boss.parts[i].alive)
+            mask |= 1ull << i;
+    }
+    return mask;
+}
+
+void SetBossPartMask(Boss& boss, unsigned long long mask)
+{
+    boss.liveParts = 0;
+    for (int i = 0; i < boss.partCount; ++i)
+    {
+        boss.parts[i].alive = (mask >> i) & 1u;
+        boss.liveParts += boss.parts[i].alive ? 1 : 0;
+    }
+    RefitBoss(boss);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "../util/config.h"
+#include "../util/type.h"
+
+#include <vector>
+
+struct SDL_Renderer;
+
+// ===== Boss：由几十个可单独摧毁的部件组成，整体移动 =====
+// 每个 Boss 带一棵小的包围盒层次（BVH），部件布局在创建时固定，建树一次；
+// 每个 tick 按 Boss 的位置重新计算部件的世界坐标并自底向上更新节点包围盒（refit）。
+// 子弹先与根节点包围盒比较，只有落在根盒内的子弹才向下遍历，不会变成"子弹数 × 部件数"次检测
+
+// 部件种类
+enum BossPartKind
+{
+    BOSS_PART_CORE = 0,   // 核心：被摧毁时整个 Boss 被消灭
+    BOSS_PART_TURRET,     // 炮塔
+    BOSS_PART_ARMOR       // 装甲板
+};
+
+// 一个部件（偏移相对 Boss 左上角）
+struct BossPart
+{
+    Vector2 offset;
+    double width;
+    double height;
+    Rect bounds;            // 世界坐标包围盒（每 tick 更新）
+    Attribute attributes;   // 生命值与击毁得分
+    int kind;               // BossPartKind
+    bool alive;
+};
+
+// 包围盒层次的节点：子节点下标总是大于父节点，逆序遍历即可自底向上更新
+struct BossBvhNode
+{
+    Rect bounds;
+    int first;    // 叶子：部件区间 [first, first + count)
+    int count;    // 0 表示内部节点
+    int left;     // 内部节点：左右子节点下标
+    int right;
+    bool empty;   // 子树中没有存活的部件
+};
+
+struct Boss
+{
+    Vector2 position;       // 左上角
+    double width;
+    double height;
+    double age;             // 出现以来的时间（秒），驱动移动轨迹
+    unsigned int id;        // 唯一编号（联机同步时用于匹配）
+    int partCount;
+    int liveParts;
+    bool destroyed;         // 核心已被摧毁，本 tick 结束时移除
+    BossPart parts[BOSS_MAX_PARTS];
+    int nodeCount;
+    BossBvhNode nodes[BOSS_MAX_PARTS * 2];
+};
+
+// ===== Boss 模块 API =====
+
+// 在指定位置创建一个 Boss（左上角），返回它（达到上限时返回 nullptr）
+Boss* CreateBoss(double x, double y);
+
+// 更新所有 Boss（定时出现、移动、更新包围盒）
+void UpdateBosses(double deltaTime);
+
+// 按当前位置更新部件和节点的包围盒
+void RefitBoss(Boss& boss);
+
+// 绘制所有 Boss（每种部件一次批量绘制）
+void RenderBosses(SDL_Renderer* renderer);
+
+// 清空所有 Boss 并重置出现计时
+void ClearBosses();
+
+// 联机客户端：把第 index 个 Boss 写成快照中的状态（编号相同时只更新位置和部件，
+// 否则按固定布局重建；保留服务器的编号，不改变出现计时）
+void SetBossReplica(int index, unsigned int id, double x, double y, unsigned long long partMask);
+// 联机客户端：只保留前 count 个 Boss
+void TruncateBossReplicas(int count);
+
+// 开启或关闭定时出现（关卡模式下 Boss 由关卡出现点生成）
+void SetBossAutoSpawn(bool enabled);
+
+// 获取 Boss 列表（供碰撞检测使用）
+std::vector<Boss>& GetBosses();
+
+// 圆与 Boss 的第一个相交的存活部件，没有时返回 -1（先测根包围盒）
+int FindBossPartHit(const Boss& boss, Circle circle);
+
+// 矩形与 Boss 的第一个相交的存活部件，没有时返回 -1
+int FindBossPartOverlap(const Boss& boss, Rect rect);
+
+// 标记部件被摧毁（包围盒在下一次 refit 时收缩）；核心被摧毁时整个 Boss 标记为 destroyed
+void DestroyBossPart(Boss& boss, int part);
+
+// 移除核心已被摧毁的 Boss，剩余的存活部件各自爆炸（不计分）
+void RemoveDestroyedBosses();
+
+// 部件中心（爆炸和声像用）
+Vector2 GetBossPartCenter(const BossPart& part);
+
+// 存活部件掩码（第 i 位对应 parts[i]，联机同步用）
+unsigned long long GetBossPartMask(const Boss& boss);
+void SetBossPartMask(Boss& boss, unsigned long long mask);
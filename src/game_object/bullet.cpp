@@ -1,28 +1,288 @@
 #include "bullet.h"
 
 #include "player.h"
+#include "spatial_index.h"
 
+#include "../audio/audio.h"
 #include "../input/input.h"
+#include "../render/sprite_batch.h"
 #include "../util/config.h"
+#include "../util/util.h"
 
 #include <SDL.h>
+#include <algorithm>
 #include <cmath>
 
 namespace
 {
-    // 所有当前存在的子弹列表
+    // 到期队列中的一项：子弹离开屏幕（或达到最长存在时间）的时刻
+    struct BulletExpiry
+    {
+        double time;
+        int slot;
+        unsigned int id;    // 槽位被复用后用编号识别过期的队列项
+    };
+
+    // 追踪导弹的槽位（每个 tick 按槽位找到导弹并转向，编号用于识别已被删除的导弹）
+    struct MissileRef
+    {
+        int slot;
+        unsigned int id;
+    };
+
+    // 所有当前存在的子弹列表（紧凑存储，删除时与最后一颗交换）
     std::vector<Bullet> g_bullets;
+    // 槽位 → 列表下标（-1 = 空槽）
+    std::vector<int> g_indexOfSlot;
+    std::vector<int> g_freeSlots;
+    // 按到期时刻排序的小顶堆；被击中的子弹留下的队列项到期时被忽略
+    std::vector<BulletExpiry> g_expiry;
+    std::vector<MissileRef> g_missiles;
+    // 子弹时钟（秒）
+    double g_time = 0.0;
+    // 下一颗子弹的编号（单调递增）
+    unsigned int g_nextBulletId = 1;
+    // 同时存在的子弹上限（0 = 不限制）
+    int g_maxBullets = 0;
+    // 圆形扫描带高度（像素）
+    int g_circleStep = 1;
+
+    bool ExpiresLater(const BulletExpiry& a, const BulletExpiry& b)
+    {
+        return a.time > b.time;
+    }
+
+    // 一维运动 x(t) = x0 + v·t + a·t²/2 最后一次位于 [lo, hi] 内的时刻（始终在外返回 -1）
+    double LastInside(double x0, double v, double a, double lo, double hi)
+    {
+        if (a == 0.0)
+        {
+            if (v > 0.0)
+                return (hi - x0) / v;
+            if (v < 0.0)
+                return (lo - x0) / v;
+            return (x0 >= lo && x0 <= hi) ? BULLET_MAX_LIFETIME : -1.0;
+        }
+
+        // 加速度为正时最终越过 hi，为负时最终越过 lo：取对应边界方程的较大根
+        double c = x0 - (a > 0.0 ? hi : lo);
+        double discriminant = v * v - 2.0 * a * c;
+        if (discriminant < 0.0)
+            return -1.0;
+        double root = std::sqrt(discriminant);
+        return a > 0.0 ? (-v + root) / a : (-v - root) / a;
+    }
+
+    // 按弹道算出子弹离开屏幕的时刻（各轴分别求解后取最小值，是偏晚的保守估计）
+    double ComputeExpiry(const Bullet& b)
+    {
+        const BulletTrajectory& tr = b.trajectory;
+        double margin = b.radius;
+        double life = BULLET_MAX_LIFETIME;
+
+        switch (tr.motion)
+        {
+        case BULLET_MOTION_SINE:
+            margin += std::fabs(tr.amplitude);  // 摆动不超过振幅
+            // fallthrough
+        case BULLET_MOTION_LINEAR:
+        case BULLET_MOTION_ACCELERATING:
+        {
+            double ax = tr.motion == BULLET_MOTION_ACCELERATING ? tr.acceleration.x : 0.0;
+            double ay = tr.motion == BULLET_MOTION_ACCELERATING ? tr.acceleration.y : 0.0;
+            double tx = LastInside(tr.origin.x, tr.velocity.x, ax, -margin, GAME_WIDTH + margin);
+            double ty = LastInside(tr.origin.y, tr.velocity.y, ay, -margin, GAME_HEIGHT + margin);
+            life = std::min(tx, ty);
+            break;
+        }
+        case BULLET_MOTION_SPIRAL:
+        {
+            // 半径超过中心到最远屏幕角的距离后不会再回到屏幕内
+            if (tr.radialSpeed > 0.0)
+            {
+                double dx = std::max(tr.origin.x, GAME_WIDTH - tr.origin.x);
+                double dy = std::max(tr.origin.y, GAME_HEIGHT - tr.origin.y);
+                life = (std::sqrt(dx * dx + dy * dy) + margin - tr.amplitude) / tr.radialSpeed;
+            }
+            break;
+        }
+        case BULLET_MOTION_HOMING:
+            // 轨迹每个 tick 都会改变，离开屏幕由转向时检查，这里只限制飞行时间
+            life = MISSILE_LIFETIME;
+            break;
+        }
+
+        return b.spawnTime + Clamp(life, 0.0, BULLET_MAX_LIFETIME);
+    }
+
+    // 弹道在发射后 t 秒的位置
+    Vector2 EvaluateTrajectory(const BulletTrajectory& tr, double t)
+    {
+        switch (tr.motion)
+        {
+        case BULLET_MOTION_SINE:
+        {
+            Vector2 p = {tr.origin.x + tr.velocity.x * t, tr.origin.y + tr.velocity.y * t};
+            double speed = Length(tr.velocity);
+            if (speed > 0.0)
+            {
+                // 沿速度的垂直方向摆动
+                double offset = tr.amplitude * std::sin(tr.angularSpeed * t + tr.phase) / speed;
+                p.x += -tr.velocity.y * offset;
+                p.y += tr.velocity.x * offset;
+            }
+            return p;
+        }
+        case BULLET_MOTION_SPIRAL:
+        {
+            double r = tr.amplitude + tr.radialSpeed * t;
+            double angle = tr.phase + tr.angularSpeed * t;
+            return {tr.origin.x + r * std::cos(angle), tr.origin.y + r * std::sin(angle)};
+        }
+        case BULLET_MOTION_ACCELERATING:
+            return {tr.origin.x + tr.velocity.x * t + 0.5 * tr.acceleration.x * t * t,
+                    tr.origin.y + tr.velocity.y * t + 0.5 * tr.acceleration.y * t * t};
+        case BULLET_MOTION_LINEAR:
+        case BULLET_MOTION_HOMING:
+        default:
+            return {tr.origin.x + tr.velocity.x * t, tr.origin.y + tr.velocity.y * t};
+        }
+    }
+
+    // 导弹转向：速度方向朝最近的目标最多转过 MISSILE_TURN_RATE·deltaTime，
+    // 然后以当前位置和时刻作为新的直线起点；飞出屏幕超过一个转弯半径后删除
+    void SteerMissiles(double deltaTime)
+    {
+        const double margin = MISSILE_SPEED / MISSILE_TURN_RATE;
+        const double maxTurn = MISSILE_TURN_RATE * deltaTime;
+        const double kTwoPi = 6.28318530717958647692;
+        for (size_t m = 0; m < g_missiles.size();)
+        {
+            int index = g_indexOfSlot[g_missiles[m].slot];
+            if (index < 0 || g_bullets[index].id != g_missiles[m].id)
+            {
+                g_missiles[m] = g_missiles.back();
+                g_missiles.pop_back();
+                continue;
+            }
+
+            Bullet& b = g_bullets[index];
+            Vector2 p = GetBulletPosition(b);
+            if (p.x < -margin || p.x > GAME_WIDTH + margin || p.y < -margin || p.y > GAME_HEIGHT + margin)
+            {
+                DestroyBullet(static_cast<size_t>(index));
+                g_missiles[m] = g_missiles.back();
+                g_missiles.pop_back();
+                continue;
+            }
+
+            Vector2 velocity = b.trajectory.velocity;
+            SpatialHit nearest;
+            if (SpatialQueryNearest(p, 1, &nearest) == 1)
+            {
+                Vector2 target = GetSpatialTarget(nearest.target).center;
+                double heading = std::atan2(velocity.y, velocity.x);
+                double turn = std::remainder(std::atan2(target.y - p.y, target.x - p.x) - heading, kTwoPi);
+                heading += Clamp(turn, -maxTurn, maxTurn);
+                velocity = {std::cos(heading) * MISSILE_SPEED, std::sin(heading) * MISSILE_SPEED};
+            }
+            b.trajectory.origin = p;
+            b.trajectory.velocity = velocity;
+            b.spawnTime = g_time;
+            ++m;
+        }
+    }
+
+    // 辅助瞄准：最近的几个目标中，第一个位于射程内、且偏离竖直向上不超过 AUTO_AIM_MAX_ANGLE 的目标
+    // 决定子弹方向；没有这样的目标时竖直向上
+    Vector2 AimVelocity(Vector2 muzzle, double speed)
+    {
+        if (AUTO_AIM_MAX_ANGLE > 0.0)
+        {
+            SpatialHit candidates[AUTO_AIM_CANDIDATES];
+            int count = SpatialQueryNearest(muzzle, AUTO_AIM_CANDIDATES, candidates);
+            for (int i = 0; i < count && candidates[i].distanceSq <= AUTO_AIM_RANGE * AUTO_AIM_RANGE; ++i)
+            {
+                Vector2 target = GetSpatialTarget(candidates[i].target).center;
+                if (target.y >= muzzle.y)
+                    continue;
+                double angle = std::atan2(target.x - muzzle.x, muzzle.y - target.y);
+                if (std::fabs(angle) <= AUTO_AIM_MAX_ANGLE)
+                    return {std::sin(angle) * speed, -std::cos(angle) * speed};
+            }
+        }
+        return {0.0, -speed};
+    }
 }
 
-// 在指定位置创建一颗子弹
-void CreateBullet(double x, double y, int damage, double speed)
+// 在指定位置创建一颗向上匀速飞行的子弹
+void CreateBullet(double x, double y, int damage, double speed, int owner)
+{
+    BulletTrajectory trajectory = {};
+    trajectory.motion = BULLET_MOTION_LINEAR;
+    trajectory.origin = {x, y};
+    trajectory.velocity = {0.0, -speed};
+    CreateBulletWithTrajectory(trajectory, g_time, damage, owner);
+}
+
+// 按弹道创建一颗子弹
+void CreateBulletWithTrajectory(const BulletTrajectory& trajectory, double spawnTime, int damage, int owner)
 {
     Bullet b = {};
-    b.position = {x, y};
+    b.trajectory = trajectory;
+    b.spawnTime = spawnTime;
     b.radius = BULLET_RADIUS;
     b.damage = damage;
-    b.speed = speed;
+    b.id = g_nextBulletId++;
+    b.owner = owner;
+
+    // 分配槽位
+    if (g_freeSlots.empty())
+    {
+        b.slot = static_cast<int>(g_indexOfSlot.size());
+        g_indexOfSlot.push_back(-1);
+    }
+    else
+    {
+        b.slot = g_freeSlots.back();
+        g_freeSlots.pop_back();
+    }
+    g_indexOfSlot[b.slot] = static_cast<int>(g_bullets.size());
     g_bullets.push_back(b);  // 添加到列表
+
+    // 到期时刻在发射时就已确定
+    g_expiry.push_back({ComputeExpiry(b), b.slot, b.id});
+    std::push_heap(g_expiry.begin(), g_expiry.end(), ExpiresLater);
+    if (trajectory.motion == BULLET_MOTION_HOMING)
+        g_missiles.push_back({b.slot, b.id});
+}
+
+Vector2 GetBulletPosition(const Bullet& bullet)
+{
+    return EvaluateTrajectory(bullet.trajectory, g_time - bullet.spawnTime);
+}
+
+double GetBulletTime()
+{
+    return g_time;
+}
+
+void DestroyBullet(size_t index)
+{
+    if (index >= g_bullets.size())
+        return;
+
+    int slot = g_bullets[index].slot;
+    g_indexOfSlot[slot] = -1;
+    g_freeSlots.push_back(slot);
+
+    // 最后一颗子弹移到空出的位置
+    if (index + 1 != g_bullets.size())
+    {
+        g_bullets[index] = g_bullets.back();
+        g_indexOfSlot[g_bullets[index].slot] = static_cast<int>(index);
+    }
+    g_bullets.pop_back();
 }
 
 // 获取子弹列表
@@ -35,58 +295,173 @@ std::vector<Bullet>& GetBullets()
 void ClearBullets()
 {
     g_bullets.clear();
+    g_indexOfSlot.clear();
+    g_freeSlots.clear();
+    g_expiry.clear();
+    g_missiles.clear();
+    g_time = 0.0;
+    // 预留到子弹容量，游戏过程中不再因扩容而分配
+    g_bullets.reserve(BULLET_CAPACITY);
+    g_indexOfSlot.reserve(BULLET_CAPACITY);
+    g_freeSlots.reserve(BULLET_CAPACITY);
+    g_expiry.reserve(BULLET_CAPACITY);
+    g_missiles.reserve(BULLET_CAPACITY);
+}
+
+void ClearBulletReplicas()
+{
+    g_bullets.clear();
+    g_indexOfSlot.clear();
+    g_freeSlots.clear();
+    g_expiry.clear();
+    g_missiles.clear();
+}
+
+void AddBulletReplica(unsigned int id, double x, double y, int owner)
+{
+    Bullet b = {};
+    b.trajectory.motion = BULLET_MOTION_LINEAR;
+    b.trajectory.origin = {x, y};
+    b.spawnTime = g_time;
+    b.radius = BULLET_RADIUS;
+    b.damage = BULLET_DAMAGE;
+    b.id = id;
+    b.owner = owner;
+    b.slot = -1;  // 客户端不运行 UpdateBullets，副本不会到期或被删除
+    g_bullets.push_back(b);
+}
+
+unsigned int GetBulletsCreated()
+{
+    return g_nextBulletId - 1;
+}
+
+void SetMaxBullets(int maxBullets)
+{
+    g_maxBullets = maxBullets > 0 ? maxBullets : 0;
+}
+
+void SetBulletCircleStep(int step)
+{
+    g_circleStep = step > 1 ? step : 1;
 }
 
 // 更新子弹
 void UpdateBullets(double deltaTime)
 {
+    // ===== 推进时钟，删除到期的子弹 =====
+    // 位置按弹道即时计算，不需要逐颗更新；只处理到期队列头部已经到期的项
+    g_time += deltaTime;
+    while (!g_expiry.empty() && g_expiry.front().time <= g_time)
+    {
+        BulletExpiry expired = g_expiry.front();
+        std::pop_heap(g_expiry.begin(), g_expiry.end(), ExpiresLater);
+        g_expiry.pop_back();
+
+        // 子弹可能已经被击中删除，槽位也可能已被新子弹复用
+        int index = g_indexOfSlot[expired.slot];
+        if (index >= 0 && g_bullets[index].id == expired.id)
+            DestroyBullet(static_cast<size_t>(index));
+    }
+
+    // ===== 导弹转向 =====
+    SteerMissiles(deltaTime);
+
     // ===== 处理射击输入 =====
-    Player* player = GetPlayer();
-    if (player)
+    // 新子弹在位置更新之后创建，在帧内的真实时刻开火：子弹按开火后经过的时间提前飞出相应距离，
+    // 冷却也从开火时刻算起（低帧率时一帧内可以连发多颗）
+    if (deltaTime <= 0.0)
+        return;
+    for (int i = 0; i < GetPlayerCount(); ++i)
     {
-        // 当按下空格且射击冷却完成时，发射一颗子弹
-        if (IsKeyDown(SDL_SCANCODE_SPACE) && player->attributes.bulletCd <= 0.0)
+        Player* player = GetPlayerByIndex(i);
+
+        // 冷却结束的时刻（帧内比例）：UpdatePlayer 已经减去了本帧时间
+        double readyAt = 1.0 + player->attributes.bulletCd / deltaTime;
+        if (readyAt < 0.0)
+            readyAt = 0.0;
+        double cooldown = player->attributes.maxBulletCd / deltaTime;  // 冷却时长（帧内比例）
+        bool fired = false;
+        bool holding = false;
+
+        for (int s = 0; s < GetPlayerInputSegmentCount(*player); ++s)
         {
-            // 从玩家中心顶部发射
-            CreateBullet(
-                player->position.x + player->width / 2.0,  // 水平中心
-                player->position.y,                         // 顶部
-                BULLET_DAMAGE,
-                BULLET_SPEED);
-            // 设置冷却时间
-            player->attributes.bulletCd = player->attributes.maxBulletCd;
+            double end = 1.0;
+            InputSegment segment = GetPlayerInputSegment(*player, s, end);
+            if (!(segment.bits & INPUT_FIRE))
+                continue;
+            holding = true;
+
+            // 按住射击键期间，每当冷却完成就发射一颗子弹
+            double fireAt = segment.start > readyAt ? segment.start : readyAt;
+            while (fireAt < end)
+            {
+                double age = (1.0 - fireAt) * deltaTime;  // 开火到帧末经过的时间
+                // 从玩家中心顶部发射，发射时刻记为帧内的真实时刻，当前位置自然补上已飞行的距离
+                // （达到子弹上限时这一发被跳过，射击节奏不变）
+                if (g_maxBullets == 0 || static_cast<int>(g_bullets.size()) < g_maxBullets)
+                {
+                    BulletTrajectory trajectory = {};
+                    trajectory.motion = BULLET_MOTION_LINEAR;
+                    trajectory.origin = {player->position.x + player->width / 2.0, player->position.y};
+                    trajectory.velocity = AimVelocity(trajectory.origin, BULLET_SPEED);
+                    CreateBulletWithTrajectory(trajectory, g_time - age, BULLET_DAMAGE, i);
+                    AudioPlay(SOUND_SHOT, 0.4f, AudioPanForX(trajectory.origin.x));
+                }
+                fired = true;
+                readyAt = fireAt + (cooldown > 0.0 ? cooldown : 1.0);
+                fireAt = readyAt;
+            }
         }
-    }
 
-    // ===== 更新子弹位置，删除超出屏幕的 =====
-    for (size_t i = 0; i < g_bullets.size();)
-    {
-        Bullet& b = g_bullets[i];
-        // 向上移动
-        b.position.y -= b.speed * deltaTime;
-        
-        // 如果子弹超出上边界，删除它
-        if (b.position.y + b.radius < 0)
+        // 设置剩余冷却时间（帧末到下次可开火的时间）
+        if (fired)
+            player->attributes.bulletCd = (readyAt - 1.0) * deltaTime;
+
+        // 按住射击键时每隔 MISSILE_COOLDOWN 秒从机头发射一枚追踪导弹（同样受子弹上限约束）
+        if (holding && player->missileCd <= 0.0)
         {
-            g_bullets.erase(g_bullets.begin() + static_cast<int>(i));
-            continue;  // 直接推进i的下一个（因为 erase 后后续元素前移）
+            player->missileCd += MISSILE_COOLDOWN;
+            if (g_maxBullets == 0 || static_cast<int>(g_bullets.size()) < g_maxBullets)
+            {
+                BulletTrajectory trajectory = {};
+                trajectory.motion = BULLET_MOTION_HOMING;
+                trajectory.origin = {player->position.x + player->width / 2.0, player->position.y};
+                trajectory.velocity = {0.0, -MISSILE_SPEED};
+                CreateBulletWithTrajectory(trajectory, g_time, MISSILE_DAMAGE, i);
+                AudioPlay(SOUND_SHOT, 0.25f, AudioPanForX(trajectory.origin.x));
+            }
         }
-        i++;
     }
 }
 
 // 绘制一个填充圆形的辅助函数
 // 使用水平线扫描算法 + 勾股定理
-static void DrawFilledCircle(SDL_Renderer* renderer, int cx, int cy, int radius)
+// step > 1 时每 step 行合并成一条矩形扫描带，绘制调用减少为约 1/step
+static void DrawFilledCircle(SDL_Renderer* renderer, int cx, int cy, int radius, int step)
 {
-    // 对每一条水平扫描线
-    for (int dy = -radius; dy <= radius; ++dy)
+    if (step <= 1)
     {
-        // 根据勾股定理计算该行的水平跨度
-        // dx^2 + dy^2 = radius^2  =>  dx = sqrt(radius^2 - dy^2)
-        int dx = static_cast<int>(std::sqrt(radius * radius - dy * dy));
-        // 绘制该行的线段
-        SDL_RenderDrawLine(renderer, cx - dx, cy + dy, cx + dx, cy + dy);
+        // 对每一条水平扫描线
+        for (int dy = -radius; dy <= radius; ++dy)
+        {
+            // 根据勾股定理计算该行的水平跨度
+            // dx^2 + dy^2 = radius^2  =>  dx = sqrt(radius^2 - dy^2)
+            int dx = static_cast<int>(std::sqrt(radius * radius - dy * dy));
+            // 绘制该行的线段
+            SDL_RenderDrawLine(renderer, cx - dx, cy + dy, cx + dx, cy + dy);
+        }
+        return;
+    }
+
+    // 低质量：扫描带的宽度取带中间一行的跨度
+    for (int top = -radius; top <= radius; top += step)
+    {
+        int height = top + step > radius + 1 ? radius + 1 - top : step;
+        int mid = top + height / 2;
+        int dx = static_cast<int>(std::sqrt(radius * radius - mid * mid));
+        SDL_Rect band{cx - dx, cy + top, dx * 2 + 1, height};
+        SDL_RenderFillRect(renderer, &band);
     }
 }
 
@@ -96,15 +471,35 @@ void RenderBullets(SDL_Renderer* renderer)
     if (!renderer)
         return;
 
-    // 设置渲染颜色为红色
+    // 图集可用时加入精灵批次（子弹精灵的锚点在圆心，敌机子弹用单独的精灵）
+    if (SpriteBatchIsActive())
+    {
+        for (const Bullet& b : g_bullets)
+        {
+            Vector2 p = GetBulletPosition(b);
+            SpriteBatchAdd(b.owner < 0 ? SPRITE_ENEMY_BULLET : SPRITE_BULLET, p.x, p.y);
+        }
+        return;
+    }
+
+    // 玩家子弹为红色，敌机子弹为黄色（颜色只在两者交替时切换）
+    bool enemyColor = false;
     SDL_SetRenderDrawColor(renderer, COLOR_RED.r, COLOR_RED.g, COLOR_RED.b, 255);
     // 遍历所有子弹并绘制
     for (const Bullet& b : g_bullets)
     {
+        if ((b.owner < 0) != enemyColor)
+        {
+            enemyColor = b.owner < 0;
+            Color c = enemyColor ? COLOR_YELLOW : COLOR_RED;
+            SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, 255);
+        }
+        Vector2 p = GetBulletPosition(b);
         DrawFilledCircle(
             renderer,
-            static_cast<int>(b.position.x),
-            static_cast<int>(b.position.y),
-            static_cast<int>(b.radius));
+            static_cast<int>(p.x),
+            static_cast<int>(p.y),
+            static_cast<int>(b.radius),
+            g_circleStep);
     }
 }
@@ -2,32 +2,86 @@
 
 #include "../util/type.h"
 
+#include <cstddef>
 #include <vector>
 
 struct SDL_Renderer;
 
+// 弹道类型：位置是发射后经过时间 t 的解析函数 p(t)，不需要每帧积分
+enum BulletMotion
+{
+    BULLET_MOTION_LINEAR = 0,    // 匀速直线：p = origin + velocity·t
+    BULLET_MOTION_SINE,          // 正弦摆动：直线运动 + 垂直于速度方向的 amplitude·sin(angularSpeed·t + phase)
+    BULLET_MOTION_SPIRAL,        // 螺旋：以 origin 为中心，半径 amplitude + radialSpeed·t，角度 phase + angularSpeed·t
+    BULLET_MOTION_ACCELERATING,  // 匀加速：p = origin + velocity·t + acceleration·t²/2
+    BULLET_MOTION_HOMING         // 追踪导弹：按直线计算，每个 tick 转向最近的目标后以当前位置和时刻重新作为起点
+};
+
+// 弹道参数（未用到的字段保持 0）
+struct BulletTrajectory
+{
+    BulletMotion motion;
+    Vector2 origin;         // 发射点（螺旋的中心）
+    Vector2 velocity;       // 初速度（像素/秒）
+    Vector2 acceleration;   // 加速度（像素/秒²）
+    double amplitude;       // 正弦振幅 / 螺旋起始半径（像素）
+    double angularSpeed;    // 正弦角频率 / 螺旋角速度（弧度/秒）
+    double phase;           // 正弦初相位 / 螺旋起始角度（弧度）
+    double radialSpeed;     // 螺旋半径增长速度（像素/秒）
+};
+
 // 子弹的数据结构
 struct Bullet
 {
-    Vector2 position;   // 位置（圆心）
+    BulletTrajectory trajectory;  // 弹道
+    double spawnTime;   // 发射时刻（子弹时钟，秒）
     double radius;      // 半径
     int damage;         // 伤害值
-    double speed;       // 移动速度（向上）
+    unsigned int id;    // 唯一编号（联机同步时用于匹配同一颗子弹）
+    int owner;          // 发射者的玩家编号（击杀得分记给该玩家），敌机子弹为 ENEMY_BULLET_OWNER
+    int slot;           // 内部槽位（到期队列通过槽位找到子弹，列表中的下标会因删除而变化）
 };
 
 // ===== 子弹模块 API =====
 
-// 在指定位置创建一颗子弹
-void CreateBullet(double x, double y, int damage, double speed);
+// 在指定位置创建一颗向上匀速飞行的子弹，owner 为发射者的玩家编号
+void CreateBullet(double x, double y, int damage, double speed, int owner);
+
+// 按弹道创建一颗子弹，spawnTime 为发射时刻（可以早于当前时刻，用于帧内开火）
+void CreateBulletWithTrajectory(const BulletTrajectory& trajectory, double spawnTime, int damage, int owner);
 
-// 更新所有子弹（移动、检测超出边界、处理射击）
+// 子弹在当前时刻的位置（圆心），按弹道即时计算
+Vector2 GetBulletPosition(const Bullet& bullet);
+
+// 子弹时钟（UpdateBullets 推进，秒）
+double GetBulletTime();
+
+// 删除列表中第 index 颗子弹（与最后一颗交换后删除，列表顺序会改变）
+void DestroyBullet(size_t index);
+
+// 更新所有子弹（推进时钟、删除到期的子弹、导弹转向、处理射击）
+// 导弹制导和辅助瞄准查询目标空间索引，需要在本 tick 的 SpatialIndexBuild 之后调用
 void UpdateBullets(double deltaTime);
 
-// 绘制所有子弹（红色圆形）
+// 绘制所有子弹（玩家子弹红色、敌机子弹黄色的圆形）
 void RenderBullets(SDL_Renderer* renderer);
 
 // 清空所有子弹
 void ClearBullets();
 
-// 获取子弹列表（供碰撞检测使用）
+// 联机客户端：按快照写入子弹（静止在给定的圆心，保留服务器的编号；
+// 不占用槽位和到期队列，不改变子弹时钟）
+void ClearBulletReplicas();
+void AddBulletReplica(unsigned int id, double x, double y, int owner);
+
+// 获取子弹列表（供碰撞检测使用，顺序不固定）
 std::vector<Bullet>& GetBullets();
+
+// 启动以来创建过的子弹总数（单调递增，用于统计每 tick 的发射数）
+unsigned int GetBulletsCreated();
+
+// 设置玩家同时存在的子弹上限（<= 0 表示不限制），达到上限时暂停开火
+void SetMaxBullets(int maxBullets);
+
+// 设置圆形绘制质量：每条扫描带的高度（像素），1 为逐行绘制
+void SetBulletCircleStep(int step);
@@ -1,83 +1,428 @@
 #include "enemy.h"
 
+#include "bullet.h"
+#include "flow_field.h"
+#include "player.h"
+
+#include "../render/sprite_batch.h"
 #include "../util/config.h"
+#include "../util/log.h"
 #include "../util/util.h"
 
 #include <SDL.h>
 
+#include <algorithm>
+
 namespace
 {
-    // 所有当前存在的敌人列表
-    std::vector<Enemy> g_enemies;
+    // ===== 类型特性表 =====
+    enum EnemyMotion
+    {
+        ENEMY_MOTION_STEERED = 0,   // 流场追踪 + 局部避让
+        ENEMY_MOTION_ZIGZAG,        // 匀速下降 + 正弦摆动
+        ENEMY_MOTION_DIVE,          // 下降到触发高度后朝玩家直线俯冲
+        ENEMY_MOTION_HOVER          // 下降到悬停线，停留射击后离开
+    };
+
+    struct EnemyTraits
+    {
+        const char* name;
+        EnemyMotion motion;
+        int health;
+        int score;
+        double speed;           // 常规移动速度（像素/秒）
+        int spawnWeight;        // 定时生成时的出现权重
+        double amplitude;       // ZIGZAG：摆动幅度（像素）
+        double frequency;       // ZIGZAG：摆动角频率（弧度/秒）
+        double triggerY;        // DIVE：开始俯冲的高度；HOVER：悬停线（左上角 y）
+        double burstSpeed;      // DIVE：俯冲速度；HOVER：离开速度
+        double hoverTime;       // HOVER：悬停时间（秒）
+        double fireInterval;    // HOVER：射击间隔（秒）
+        Uint8 r, g, b;          // 无图集时的颜色
+    };
+
+    constexpr EnemyTraits kTraits[] = {
+        {"basic", ENEMY_MOTION_STEERED, ENEMY_HEALTH, ENEMY_SCORE, ENEMY_SPEED, 6, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 220, 60, 60},
+        {"zigzag", ENEMY_MOTION_ZIGZAG, 1, 15, 160.0, 3, 90.0, 3.0, 0.0, 0.0, 0.0, 0.0, 230, 140, 60},
+        {"diver", ENEMY_MOTION_DIVE, 1, 20, 90.0, 2, 0.0, 0.0, 220.0, 520.0, 0.0, 0.0, 200, 80, 200},
+        {"tank", ENEMY_MOTION_STEERED, 6, 60, 90.0, 1, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 140, 40, 40},
+        {"shooter", ENEMY_MOTION_HOVER, 2, 30, 180.0, 2, 0.0, 0.0, 140.0, 220.0, 4.0, 1.2, 230, 200, 60},
+    };
+    static_assert(sizeof(kTraits) / sizeof(kTraits[0]) == ENEMY_TYPE_COUNT, "One traits entry per enemy type");
+    static_assert(SPRITE_ENEMY_SHOOTER - SPRITE_ENEMY == ENEMY_TYPE_SHOOTER, "Enemy sprites follow EnemyType order");
+
+    constexpr int TotalSpawnWeight()
+    {
+        int total = 0;
+        for (const EnemyTraits& traits : kTraits)
+            total += traits.spawnWeight;
+        return total;
+    }
+
+    // 每种类型一个数组（数组内按编号有序）
+    std::vector<Enemy> g_batches[ENEMY_TYPE_COUNT];
     // 敌人生成计时器（累加器模式）
     double g_spawnTimer = 0.0;
+    // 下一个敌人的编号（单调递增，保证每个数组按编号有序）
+    unsigned int g_nextEnemyId = 1;
+    // 同时存在的敌机上限（0 = 不限制）
+    int g_maxEnemies = 0;
+    // 是否定时生成
+    bool g_autoSpawn = true;
+
+    // ===== 避让用的空间哈希（每个追踪型数组更新前重建，只与同类型的敌机避让）=====
+    // 格子边长等于避让半径，只需检查 3×3 个格子
+    const int kSeparationColumns = static_cast<int>(GAME_WIDTH / ENEMY_SEPARATION_RADIUS) + 1;
+    const int kSeparationRows = static_cast<int>(GAME_HEIGHT / ENEMY_SEPARATION_RADIUS) + 1;
+    std::vector<int> g_cellHead;  // 每个格子第一个敌人的下标（-1 = 空）
+    std::vector<int> g_cellNext;  // 同格子链表中的下一个敌人
+    std::vector<Vector2> g_centers;
+    std::vector<Vector2> g_steering;
+
+    int SeparationCell(Vector2 center)
+    {
+        int cx = static_cast<int>(Clamp(center.x / ENEMY_SEPARATION_RADIUS, 0.0, kSeparationColumns - 1.0));
+        int cy = static_cast<int>(Clamp(center.y / ENEMY_SEPARATION_RADIUS, 0.0, kSeparationRows - 1.0));
+        return cy * kSeparationColumns + cx;
+    }
+
+    Vector2 EnemyCenter(const Enemy& e)
+    {
+        return {e.position.x + e.width / 2.0, e.position.y + e.height / 2.0};
+    }
+
+    // 离 from 最近的玩家中心（没有玩家时返回正下方）
+    Vector2 NearestPlayerCenter(Vector2 from)
+    {
+        Vector2 best = {from.x, GAME_HEIGHT};
+        double bestSq = -1.0;
+        for (int i = 0; i < GetPlayerCount(); ++i)
+        {
+            const Player* player = GetPlayerByIndex(i);
+            Vector2 c = {player->position.x + player->width / 2.0, player->position.y + player->height / 2.0};
+            double dx = c.x - from.x, dy = c.y - from.y;
+            double distSq = dx * dx + dy * dy;
+            if (bestSq < 0.0 || distSq < bestSq)
+            {
+                best = c;
+                bestSq = distSq;
+            }
+        }
+        return best;
+    }
+
+    // 批量计算一个数组中所有敌人的移动方向：流场追踪 + 局部避让
+    void ComputeSteering(const std::vector<Enemy>& batch)
+    {
+        const int count = static_cast<int>(batch.size());
+        g_centers.resize(count);
+        g_steering.resize(count);
+        g_cellNext.resize(count);
+        g_cellHead.assign(kSeparationColumns * kSeparationRows, -1);
+
+        // 第一遍：收集中心点并挂入空间哈希
+        for (int i = 0; i < count; ++i)
+        {
+            g_centers[i] = EnemyCenter(batch[i]);
+            int cell = SeparationCell(g_centers[i]);
+            g_cellNext[i] = g_cellHead[cell];
+            g_cellHead[cell] = i;
+        }
+
+        // 第二遍：采样流场并叠加避让力（邻居数量有上限，单个敌机开销恒定）
+        const double radiusSq = ENEMY_SEPARATION_RADIUS * ENEMY_SEPARATION_RADIUS;
+        for (int i = 0; i < count; ++i)
+        {
+            Vector2 c = g_centers[i];
+            Vector2 dir = FlowFieldSample(c);
+            // 敌机始终保持向下的分量，只在横向上追踪玩家
+            if (dir.y < ENEMY_MIN_DESCENT)
+                dir.y = ENEMY_MIN_DESCENT;
+            dir = Normalize(dir);
+
+            Vector2 push = {0.0, 0.0};
+            int neighbors = 0;
+            int cx = static_cast<int>(Clamp(c.x / ENEMY_SEPARATION_RADIUS, 0.0, kSeparationColumns - 1.0));
+            int cy = static_cast<int>(Clamp(c.y / ENEMY_SEPARATION_RADIUS, 0.0, kSeparationRows - 1.0));
+            for (int ny = cy - 1; ny <= cy + 1 && neighbors < ENEMY_SEPARATION_NEIGHBORS; ++ny)
+            {
+                for (int nx = cx - 1; nx <= cx + 1 && neighbors < ENEMY_SEPARATION_NEIGHBORS; ++nx)
+                {
+                    if (nx < 0 || ny < 0 || nx >= kSeparationColumns || ny >= kSeparationRows)
+                        continue;
+                    for (int j = g_cellHead[ny * kSeparationColumns + nx];
+                         j >= 0 && neighbors < ENEMY_SEPARATION_NEIGHBORS; j = g_cellNext[j])
+                    {
+                        if (j == i)
+                            continue;
+                        double dx = c.x - g_centers[j].x;
+                        double dy = c.y - g_centers[j].y;
+                        double distSq = dx * dx + dy * dy;
+                        if (distSq >= radiusSq || distSq < 1e-6)
+                            continue;
+                        // 越近推力越大：(1 - d/r) 方向远离邻居
+                        double dist = std::sqrt(distSq);
+                        double strength = 1.0 - dist / ENEMY_SEPARATION_RADIUS;
+                        push.x += dx / dist * strength;
+                        push.y += dy / dist * strength;
+                        neighbors++;
+                    }
+                }
+            }
+
+            Vector2 steer = {dir.x + push.x * ENEMY_SEPARATION_WEIGHT, dir.y + push.y * ENEMY_SEPARATION_WEIGHT};
+            // 避让不能把敌机推得向上飞
+            if (steer.y < 0.0)
+                steer.y = 0.0;
+            g_steering[i] = Length(steer) > 1e-6 ? Normalize(steer) : Vector2{0.0, 1.0};
+        }
+    }
+
+    // 射手向最近的玩家发射一颗直线子弹（从机头中央发出）
+    void FireAtPlayer(const Enemy& e)
+    {
+        Vector2 origin = {e.position.x + e.width / 2.0, e.position.y + e.height};
+        Vector2 target = NearestPlayerCenter(origin);
+        Vector2 dir = Normalize({target.x - origin.x, target.y - origin.y});
+        BulletTrajectory trajectory = {};
+        trajectory.motion = BULLET_MOTION_LINEAR;
+        trajectory.origin = origin;
+        trajectory.velocity = {dir.x * ENEMY_BULLET_SPEED, dir.y * ENEMY_BULLET_SPEED};
+        CreateBulletWithTrajectory(trajectory, GetBulletTime(), ENEMY_BULLET_DAMAGE, ENEMY_BULLET_OWNER);
+    }
+
+    // 一种类型的更新：特性在编译期已知，移动方式由 if constexpr 选出，循环中没有按类型的分支；
+    // 增加类型只会增加实例化，不影响已有类型的循环
+    template <EnemyType T>
+    void UpdateBatch(std::vector<Enemy>& batch, double deltaTime)
+    {
+        constexpr EnemyTraits traits = kTraits[T];
+        if constexpr (traits.motion == ENEMY_MOTION_STEERED)
+            ComputeSteering(batch);
+
+        size_t kept = 0;
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            Enemy& e = batch[i];
+            e.age += deltaTime;
+            if constexpr (traits.motion == ENEMY_MOTION_STEERED)
+            {
+                e.position.x += g_steering[i].x * traits.speed * deltaTime;
+                e.position.y += g_steering[i].y * traits.speed * deltaTime;
+            }
+            else if constexpr (traits.motion == ENEMY_MOTION_ZIGZAG)
+            {
+                e.position.y += traits.speed * deltaTime;
+                e.position.x = e.anchorX + traits.amplitude * std::sin(traits.frequency * e.age);
+            }
+            else if constexpr (traits.motion == ENEMY_MOTION_DIVE)
+            {
+                if (e.velocity.y > 0.0)
+                {
+                    e.position.x += e.velocity.x * deltaTime;
+                    e.position.y += e.velocity.y * deltaTime;
+                }
+                else
+                {
+                    e.position.y += traits.speed * deltaTime;
+                    if (e.position.y >= traits.triggerY)
+                    {
+                        // 朝玩家当前位置俯冲（同样不会掉头向上）
+                        Vector2 c = EnemyCenter(e);
+                        Vector2 target = NearestPlayerCenter(c);
+                        Vector2 dir = {target.x - c.x, target.y - c.y};
+                        if (dir.y < ENEMY_MIN_DESCENT * Length(dir))
+                            dir.y = ENEMY_MIN_DESCENT * Length(dir) + 1e-6;
+                        dir = Normalize(dir);
+                        e.velocity = {dir.x * traits.burstSpeed, dir.y * traits.burstSpeed};
+                    }
+                }
+            }
+            else
+            {
+                static_assert(traits.motion == ENEMY_MOTION_HOVER, "Unhandled enemy motion");
+                if (e.velocity.y > 0.0)
+                    e.position.y += e.velocity.y * deltaTime;
+                else if (e.position.y < traits.triggerY)
+                    e.position.y = std::min(traits.triggerY, e.position.y + traits.speed * deltaTime);
+                else
+                {
+                    e.attributes.bulletCd -= deltaTime;
+                    if (e.attributes.bulletCd <= 0.0)
+                    {
+                        FireAtPlayer(e);
+                        e.attributes.bulletCd += e.attributes.maxBulletCd;
+                    }
+                    e.hoverTime += deltaTime;
+                    if (e.hoverTime >= traits.hoverTime)
+                        e.velocity = {0.0, traits.burstSpeed};
+                }
+            }
+            e.position.x = Clamp(e.position.x, 0.0, GAME_WIDTH - e.width);
+
+            // 超出下边界的敌人被丢弃（原地压缩，保持按编号有序）
+            if (e.position.y > GAME_HEIGHT + 50.0)
+                continue;
+            batch[kept++] = e;
+        }
+        batch.resize(kept);
+    }
+
+    using UpdateBatchFunction = void (*)(std::vector<Enemy>&, double);
+    constexpr UpdateBatchFunction kUpdateBatch[] = {
+        UpdateBatch<ENEMY_TYPE_BASIC>,
+        UpdateBatch<ENEMY_TYPE_ZIGZAG>,
+        UpdateBatch<ENEMY_TYPE_DIVER>,
+        UpdateBatch<ENEMY_TYPE_TANK>,
+        UpdateBatch<ENEMY_TYPE_SHOOTER>,
+    };
+    static_assert(sizeof(kUpdateBatch) / sizeof(kUpdateBatch[0]) == ENEMY_TYPE_COUNT, "One kernel per enemy type");
 }
 
 // 在指定位置创建一个敌人
-void CreateEnemy(double x, double y)
+void CreateEnemy(double x, double y, EnemyType type)
 {
+    const EnemyTraits& traits = kTraits[type];
     Enemy e = {};
     e.position = {x, y};
     e.width = ENEMY_WIDTH;
     e.height = ENEMY_HEIGHT;
     // 初始化属性
-    e.attributes.health = ENEMY_HEALTH;
-    e.attributes.score = ENEMY_SCORE;
-    e.attributes.speed = ENEMY_SPEED;
-    e.attributes.maxBulletCd = 0.0;  // 敌人不射击
+    e.attributes.health = traits.health;
+    e.attributes.score = traits.score;
+    e.attributes.speed = traits.speed;
+    e.attributes.maxBulletCd = traits.fireInterval;  // 只有射手射击
     e.attributes.bulletCd = 0.0;
+    e.id = g_nextEnemyId++;
+    e.anchorX = x;
+
+    g_batches[type].push_back(e);  // 添加到该类型的数组
+    LogWrite(LOG_ENEMY_SPAWN, e.id, x, y);
+}
+
+// 在屏幕上方（y = -100）的随机位置创建一个敌人，之字形留出摆动的余量
+void CreateRandomEnemy(EnemyType type)
+{
+    double margin = 30.0 + kTraits[type].amplitude;
+    CreateEnemy(GetRandomDouble(margin, GAME_WIDTH - ENEMY_WIDTH - margin), -100.0, type);
+}
+
+EnemyType RandomEnemyType()
+{
+    int pick = GetRandomInt(0, TotalSpawnWeight() - 1);
+    for (int type = 0; type < ENEMY_TYPE_COUNT; ++type)
+    {
+        pick -= kTraits[type].spawnWeight;
+        if (pick < 0)
+            return static_cast<EnemyType>(type);
+    }
+    return ENEMY_TYPE_BASIC;
+}
 
-    g_enemies.push_back(e);  // 添加到列表
+std::vector<Enemy>& GetEnemyBatch(EnemyType type)
+{
+    return g_batches[type];
 }
 
-// 创建一个随机位置的敌人
-// 敌人生成在屏幕上方（y = -100）
-void CreateRandomEnemy()
+SpriteId GetEnemySprite(EnemyType type)
 {
-    CreateEnemy(
-        GetRandomDouble(30.0, GAME_WIDTH - ENEMY_WIDTH - 30.0),  // 随机 x
-        -100.0);  // 屏幕上方
+    return static_cast<SpriteId>(SPRITE_ENEMY + type);
 }
 
-// 获取敌人列表
-std::vector<Enemy>& GetEnemies()
+int GetEnemyCount()
 {
-    return g_enemies;
+    size_t count = 0;
+    for (const std::vector<Enemy>& batch : g_batches)
+        count += batch.size();
+    return static_cast<int>(count);
 }
 
 // 清空所有敌人
 void ClearEnemies()
 {
-    g_enemies.clear();
+    // 每个数组都预留到敌机容量，游戏过程中不再因扩容而分配
+    for (std::vector<Enemy>& batch : g_batches)
+    {
+        batch.clear();
+        batch.reserve(ENEMY_CAPACITY);
+    }
+    g_centers.reserve(ENEMY_CAPACITY);
+    g_steering.reserve(ENEMY_CAPACITY);
+    g_cellNext.reserve(ENEMY_CAPACITY);
     g_spawnTimer = 0.0;  // 重置计时器
+    FlowFieldInit();
+}
+
+void ClearEnemyReplicas()
+{
+    for (std::vector<Enemy>& batch : g_batches)
+        batch.clear();
+}
+
+void AddEnemyReplica(EnemyType type, unsigned int id, double x, double y)
+{
+    const EnemyTraits& traits = kTraits[type];
+    Enemy e = {};
+    e.position = {x, y};
+    e.width = ENEMY_WIDTH;
+    e.height = ENEMY_HEIGHT;
+    e.attributes.health = traits.health;
+    e.attributes.score = traits.score;
+    e.attributes.speed = traits.speed;
+    e.id = id;
+    e.anchorX = x;
+    g_batches[type].push_back(e);
+}
+
+void RemoveDestroyedEnemies()
+{
+    for (std::vector<Enemy>& batch : g_batches)
+    {
+        batch.erase(std::remove_if(batch.begin(), batch.end(),
+                                   [](const Enemy& e) { return e.attributes.health <= 0; }),
+                    batch.end());
+    }
+}
+
+unsigned int GetEnemiesCreated()
+{
+    return g_nextEnemyId - 1;
+}
+
+void SetEnemyAutoSpawn(bool enabled)
+{
+    g_autoSpawn = enabled;
+    g_spawnTimer = 0.0;
+}
+
+void SetMaxEnemies(int maxEnemies)
+{
+    g_maxEnemies = maxEnemies > 0 ? maxEnemies : 0;
 }
 
 // 更新敌人
 void UpdateEnemies(double deltaTime)
 {
     // ===== 定时生成敌人（累加器模式）=====
-    g_spawnTimer += deltaTime;
-    // 当计时器达到生成间隔时，生成新敌人
+    if (g_autoSpawn)
+        g_spawnTimer += deltaTime;
+    // 当计时器达到生成间隔时，按出现权重随机选一种类型生成
     while (g_spawnTimer >= ENEMY_SPAWN_INTERVAL)
     {
-        CreateRandomEnemy();
+        // 达到上限时这一次生成被跳过
+        if (g_maxEnemies == 0 || GetEnemyCount() < g_maxEnemies)
+            CreateRandomEnemy(RandomEnemyType());
         g_spawnTimer -= ENEMY_SPAWN_INTERVAL;  // 扣掉一个周期
     }
 
-    // ===== 更新所有敌人位置，删除超出屏幕的 =====
-    for (size_t i = 0; i < g_enemies.size();)
-    {
-        Enemy& e = g_enemies[i];
-        // 向下移动
-        e.position.y += e.attributes.speed * deltaTime;
+    // ===== 流场只在玩家换格时重建 =====
+    FlowFieldUpdate();
 
-        // 如果敌人超出下边界，删除它
-        if (e.position.y > GAME_HEIGHT + 50.0)
-        {
-            g_enemies.erase(g_enemies.begin() + static_cast<int>(i));
-            continue;  // 直接推进i的下一个
-        }
-        i++;
+    // ===== 逐类型批量更新位置，删除超出屏幕的 =====
+    for (int type = 0; type < ENEMY_TYPE_COUNT; ++type)
+    {
+        if (!g_batches[type].empty())
+            kUpdateBatch[type](g_batches[type], deltaTime);
     }
 }
 
@@ -87,16 +432,31 @@ void RenderEnemies(SDL_Renderer* renderer)
     if (!renderer)
         return;
 
-    // 设置渲染颜色为深红色
-    SDL_SetRenderDrawColor(renderer, 220, 60, 60, 255);
-    // 遍历所有敌人并绘制
-    for (const Enemy& e : g_enemies)
-    {
-        SDL_Rect r;
-        r.x = static_cast<int>(e.position.x);
-        r.y = static_cast<int>(e.position.y);
-        r.w = static_cast<int>(e.width);
-        r.h = static_cast<int>(e.height);
-        SDL_RenderFillRect(renderer, &r);
+    // 图集可用时加入精灵批次（每种类型一个精灵）
+    if (SpriteBatchIsActive())
+    {
+        for (int type = 0; type < ENEMY_TYPE_COUNT; ++type)
+        {
+            SpriteId sprite = GetEnemySprite(static_cast<EnemyType>(type));
+            for (const Enemy& e : g_batches[type])
+                SpriteBatchAdd(sprite, e.position.x, e.position.y);
+        }
+        return;
+    }
+
+    // 每种类型一种颜色
+    for (int type = 0; type < ENEMY_TYPE_COUNT; ++type)
+    {
+        const EnemyTraits& traits = kTraits[type];
+        SDL_SetRenderDrawColor(renderer, traits.r, traits.g, traits.b, 255);
+        for (const Enemy& e : g_batches[type])
+        {
+            SDL_Rect r;
+            r.x = static_cast<int>(e.position.x);
+            r.y = static_cast<int>(e.position.y);
+            r.w = static_cast<int>(e.width);
+            r.h = static_cast<int>(e.height);
+            SDL_RenderFillRect(renderer, &r);
+        }
     }
 }
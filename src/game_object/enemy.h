@@ -1,36 +1,79 @@
 #pragma once
 
+#include "../render/sprite_atlas.h"
 #include "../util/type.h"
 
 #include <vector>
 
 struct SDL_Renderer;
 
+// 敌机类型：每种类型的参数和行为由 enemy.cpp 中的 constexpr 特性表决定，
+// 同一类型的敌机存放在各自的数组中，由按类型实例化的更新函数批量处理（循环中没有按类型的分支）
+enum EnemyType
+{
+    ENEMY_TYPE_BASIC = 0,   // 基础型：沿流场追踪玩家并互相避让
+    ENEMY_TYPE_ZIGZAG,      // 之字形：匀速下降，左右正弦摆动
+    ENEMY_TYPE_DIVER,       // 俯冲型：缓慢下降，到达触发高度后朝玩家直线俯冲
+    ENEMY_TYPE_TANK,        // 重装型：生命高、速度慢，同样追踪玩家
+    ENEMY_TYPE_SHOOTER,     // 射手：下降到悬停线后停留并向最近的玩家射击，之后离开
+    ENEMY_TYPE_COUNT
+};
+
 // 敌机的数据结构
 struct Enemy
 {
     Vector2 position;       // 位置（左上角坐标）
     double width;           // 宽度
     double height;          // 高度
-    Attribute attributes;   // 属性（生命，分数，速度等）
+    Attribute attributes;   // 属性（生命，分数，速度，射击冷却）
+    unsigned int id;        // 唯一编号（联机同步时用于匹配同一个敌人）
+    double age;             // 出现以来的时间（秒）
+    double anchorX;         // 之字形摆动的中心线
+    double hoverTime;       // 射手已经悬停的时间（秒）
+    Vector2 velocity;       // 俯冲 / 离开时的速度（零表示还在按类型的常规方式移动）
 };
 
 // ===== 敌人模块 API =====
 
 // 在指定位置创建一个敌人
-void CreateEnemy(double x, double y);
+void CreateEnemy(double x, double y, EnemyType type = ENEMY_TYPE_BASIC);
 
-// 创建一个随机位置的敌人（在屏幕上方）
-void CreateRandomEnemy();
+// 在屏幕上方的随机位置创建一个指定类型的敌人
+void CreateRandomEnemy(EnemyType type);
 
-// 更新所有敌人（移动、生成新敌人、删除超出屏幕的）
+// 按各类型的出现权重随机选择一个类型
+EnemyType RandomEnemyType();
+
+// 更新所有敌人（生成新敌人、逐类型批量移动、删除超出屏幕的）
 void UpdateEnemies(double deltaTime);
 
-// 绘制所有敌人（红色矩形）
+// 绘制所有敌人（无图集时每种类型一种颜色）
 void RenderEnemies(SDL_Renderer* renderer);
 
 // 清空所有敌人
 void ClearEnemies();
 
-// 获取敌人列表（供碰撞检测使用）
-std::vector<Enemy>& GetEnemies();
+// 联机客户端：按快照写入敌机（保留服务器的编号，不记日志、不重置生成计时和流场）
+void ClearEnemyReplicas();
+void AddEnemyReplica(EnemyType type, unsigned int id, double x, double y);
+
+// 移除生命值 <= 0 的敌人（碰撞检测只扣血，事件分发之后统一移除，保持其余敌人的顺序）
+void RemoveDestroyedEnemies();
+
+// 获取某一类型的敌人数组（供碰撞检测、目标索引和联机快照使用，数组内按编号有序）
+std::vector<Enemy>& GetEnemyBatch(EnemyType type);
+
+// 某一类型敌机的精灵（绘制与碰撞遮罩共用）
+SpriteId GetEnemySprite(EnemyType type);
+
+// 所有类型的敌人总数
+int GetEnemyCount();
+
+// 启动以来创建过的敌机总数（单调递增，用于统计每 tick 的生成数）
+unsigned int GetEnemiesCreated();
+
+// 开启或关闭定时生成（关卡模式下敌机由关卡出现点生成）
+void SetEnemyAutoSpawn(bool enabled);
+
+// 设置同时存在的敌机上限（<= 0 表示不限制），达到上限时暂停生成
+void SetMaxEnemies(int maxEnemies);
@@ -0,0 +1,178 @@
+#include "flow_field.h"
+
+#include "player.h"
+
+#include "../util/config.h"
+#include "../util/util.h"
+
+#include <array>
+
+namespace
+{
+    const int kColumns = (GAME_WIDTH + FLOW_CELL_SIZE - 1) / FLOW_CELL_SIZE;
+    const int kRows = (GAME_HEIGHT + FLOW_CELL_SIZE - 1) / FLOW_CELL_SIZE;
+    const int kCellCount = kColumns * kRows;
+    const int kUnreachable = 0x7FFFFFFF;
+
+    // 每个格子：到玩家的步数、前进方向、是否障碍
+    std::array<int, kCellCount> g_cost = {};
+    std::array<Vector2, kCellCount> g_direction = {};
+    std::array<bool, kCellCount> g_blocked = {};
+    // 广度优先搜索的队列（每个格子最多入队一次）
+    std::array<int, kCellCount> g_queue = {};
+
+    // 上次重建时各玩家所在的格子（-1 = 不存在）
+    std::array<int, MAX_PLAYERS> g_playerCells = {};
+    bool g_dirty = true;
+    int g_rebuildCount = 0;
+
+    int CellIndex(int cx, int cy)
+    {
+        return cy * kColumns + cx;
+    }
+
+    // 位置所在的格子（超出区域时夹到边缘格子）
+    int CellOf(Vector2 p)
+    {
+        int cx = static_cast<int>(Clamp(p.x / FLOW_CELL_SIZE, 0.0, kColumns - 1.0));
+        int cy = static_cast<int>(Clamp(p.y / FLOW_CELL_SIZE, 0.0, kRows - 1.0));
+        return CellIndex(cx, cy);
+    }
+
+    Vector2 PlayerCenter(const Player& player)
+    {
+        return {player.position.x + player.width / 2.0, player.position.y + player.height / 2.0};
+    }
+
+    // 以所有玩家所在格子为源做多源广度优先搜索，再为每个格子选出代价最小的相邻格子
+    void Rebuild()
+    {
+        g_cost.fill(kUnreachable);
+        int head = 0, tail = 0;
+        for (int cell : g_playerCells)
+        {
+            if (cell < 0 || g_blocked[cell] || g_cost[cell] == 0)
+                continue;
+            g_cost[cell] = 0;
+            g_queue[tail++] = cell;
+        }
+
+        static const int kDx4[4] = {1, -1, 0, 0};
+        static const int kDy4[4] = {0, 0, 1, -1};
+        while (head < tail)
+        {
+            int cell = g_queue[head++];
+            int cx = cell % kColumns, cy = cell / kColumns;
+            for (int k = 0; k < 4; ++k)
+            {
+                int nx = cx + kDx4[k], ny = cy + kDy4[k];
+                if (nx < 0 || ny < 0 || nx >= kColumns || ny >= kRows)
+                    continue;
+                int next = CellIndex(nx, ny);
+                if (g_blocked[next] || g_cost[next] != kUnreachable)
+                    continue;
+                g_cost[next] = g_cost[cell] + 1;
+                g_queue[tail++] = next;
+            }
+        }
+
+        // 方向：指向 8 邻域中代价最小的格子（斜向时两侧都不能是障碍，避免穿角）
+        for (int cy = 0; cy < kRows; ++cy)
+        {
+            for (int cx = 0; cx < kColumns; ++cx)
+            {
+                int cell = CellIndex(cx, cy);
+                g_direction[cell] = {0.0, 0.0};
+                if (g_cost[cell] == kUnreachable || g_cost[cell] == 0)
+                    continue;
+
+                int best = g_cost[cell];
+                for (int dy = -1; dy <= 1; ++dy)
+                {
+                    for (int dx = -1; dx <= 1; ++dx)
+                    {
+                        int nx = cx + dx, ny = cy + dy;
+                        if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= kColumns || ny >= kRows)
+                            continue;
+                        if (dx != 0 && dy != 0 && (g_blocked[CellIndex(nx, cy)] || g_blocked[CellIndex(cx, ny)]))
+                            continue;
+                        int cost = g_cost[CellIndex(nx, ny)];
+                        if (cost < best)
+                        {
+                            best = cost;
+                            g_direction[cell] = Normalize({static_cast<double>(dx), static_cast<double>(dy)});
+                        }
+                    }
+                }
+            }
+        }
+        g_rebuildCount++;
+    }
+}
+
+void FlowFieldInit()
+{
+    g_blocked.fill(false);
+    g_playerCells.fill(-1);
+    g_dirty = true;
+}
+
+void FlowFieldUpdate()
+{
+    // 只有玩家换到另一个格子时才需要重建
+    for (int i = 0; i < MAX_PLAYERS; ++i)
+    {
+        const Player* player = GetPlayerByIndex(i);
+        int cell = player ? CellOf(PlayerCenter(*player)) : -1;
+        if (cell != g_playerCells[i])
+        {
+            g_playerCells[i] = cell;
+            g_dirty = true;
+        }
+    }
+
+    if (g_dirty)
+    {
+        Rebuild();
+        g_dirty = false;
+    }
+}
+
+Vector2 FlowFieldSample(Vector2 position)
+{
+    int cell = CellOf(position);
+    if (g_cost[cell] != 0)
+        return g_direction[cell];
+
+    // 已在玩家所在格子：直接朝最近的玩家飞
+    Vector2 best = {0.0, 0.0};
+    double bestDistance = 0.0;
+    for (int i = 0; i < GetPlayerCount(); ++i)
+    {
+        Vector2 center = PlayerCenter(*GetPlayerByIndex(i));
+        double distance = Distance(position, center);
+        if (i == 0 || distance < bestDistance)
+        {
+            bestDistance = distance;
+            best = Normalize({center.x - position.x, center.y - position.y});
+        }
+    }
+    return best;
+}
+
+void FlowFieldSetBlocked(int cellX, int cellY, bool blocked)
+{
+    if (cellX < 0 || cellY < 0 || cellX >= kColumns || cellY >= kRows)
+        return;
+    int cell = CellIndex(cellX, cellY);
+    if (g_blocked[cell] != blocked)
+    {
+        g_blocked[cell] = blocked;
+        g_dirty = true;
+    }
+}
+
+int FlowFieldGetRebuildCount()
+{
+    return g_rebuildCount;
+}
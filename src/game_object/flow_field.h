@@ -0,0 +1,23 @@
+#pragma once
+
+#include "../util/type.h"
+
+// ===== 流场寻路 =====
+// 把 GAME_WIDTH × GAME_HEIGHT 划分为粗网格，从玩家所在格子出发做一次广度优先搜索，
+// 每个格子存一个指向"离玩家更近的相邻格子"的方向；
+// 只有玩家移动到另一个格子（或障碍变化）时才重新计算，敌人只需 O(1) 采样
+
+// 清空障碍并标记需要重建
+void FlowFieldInit();
+
+// 检查玩家所在格子，有变化时重建流场（每帧在更新敌人前调用）
+void FlowFieldUpdate();
+
+// 采样某个位置的前进方向（单位向量）；位于玩家所在格子时直接指向最近的玩家
+Vector2 FlowFieldSample(Vector2 position);
+
+// 设置某个格子是否为障碍（越界忽略），会触发下一次 FlowFieldUpdate 重建
+void FlowFieldSetBlocked(int cellX, int cellY, bool blocked);
+
+// 流场重建的累计次数（用于确认"只在换格时重建"）
+int FlowFieldGetRebuildCount();
@@ -0,0 +1,238 @@
+#include "particle.h"
+
+#include "../util/config.h"
+
+#include <SDL.h>
+#include <cmath>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_USE_SSE 1
+#endif
+
+namespace
+{
+    const unsigned int kMask = PARTICLE_CAPACITY - 1;
+    static_assert((PARTICLE_CAPACITY & (PARTICLE_CAPACITY - 1)) == 0, "PARTICLE_CAPACITY must be a power of two");
+
+    // ----- SoA 数据：同一字段连续存放，便于向量化 -----
+    alignas(16) float g_posX[PARTICLE_CAPACITY];
+    alignas(16) float g_posY[PARTICLE_CAPACITY];
+    alignas(16) float g_velX[PARTICLE_CAPACITY];
+    alignas(16) float g_velY[PARTICLE_CAPACITY];
+    alignas(16) float g_life[PARTICLE_CAPACITY];       // 剩余寿命（秒），<= 0 表示已死亡
+    alignas(16) float g_lifeScale[PARTICLE_CAPACITY];  // 1 / 初始寿命，用于计算淡出
+    unsigned int g_color[PARTICLE_CAPACITY];           // 0xRRGGBBAA
+
+    // 环形缓冲区：g_head 是最早的粒子，g_count 是环中的粒子数
+    unsigned int g_head = 0;
+    unsigned int g_count = 0;
+    unsigned int g_budget = PARTICLE_BUDGET;
+
+    // 绘制缓冲（第一次绘制时按 PARTICLE_RENDER_BUDGET 一次性分配）
+    std::vector<SDL_Vertex> g_vertices;
+    std::vector<int> g_indices;
+
+    // 粒子专用的快速随机数（xorshift32），不与游戏逻辑共享 rand() 序列
+    unsigned int g_rngState = 0x9E3779B9u;
+
+    float RandomFloat(float min, float max)
+    {
+        g_rngState ^= g_rngState << 13;
+        g_rngState ^= g_rngState >> 17;
+        g_rngState ^= g_rngState << 5;
+        return min + (max - min) * static_cast<float>(g_rngState >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // 丢弃最早的 n 个粒子
+    void DropOldest(unsigned int n)
+    {
+        if (n > g_count)
+            n = g_count;
+        g_head = (g_head + n) & kMask;
+        g_count -= n;
+    }
+
+    // 更新下标 [begin, end) 的连续粒子
+    void UpdateRange(unsigned int begin, unsigned int end, float dt)
+    {
+        float* __restrict px = g_posX;
+        float* __restrict py = g_posY;
+        const float* __restrict vx = g_velX;
+        float* __restrict vy = g_velY;
+        float* __restrict life = g_life;
+        const float gravity = static_cast<float>(PARTICLE_GRAVITY) * dt;
+
+        unsigned int i = begin;
+#ifdef PARTICLE_USE_SSE
+        // 每次处理 4 个粒子
+        const __m128 vdt = _mm_set1_ps(dt);
+        const __m128 vgravity = _mm_set1_ps(gravity);
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 velY = _mm_add_ps(_mm_loadu_ps(vy + i), vgravity);
+            _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(_mm_loadu_ps(vx + i), vdt)));
+            _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(velY, vdt)));
+            _mm_storeu_ps(vy + i, velY);
+            _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), vdt));
+        }
+#endif
+        // 剩余部分（或不支持 SSE 时的全部）用标量循环，编译器同样可以自动向量化
+        for (; i < end; ++i)
+        {
+            vy[i] += gravity;
+            px[i] += vx[i] * dt;
+            py[i] += vy[i] * dt;
+            life[i] -= dt;
+        }
+    }
+
+    // 生成一圈随机方向的粒子
+    void SpawnBurst(double x, double y, int count, float minSpeed, float maxSpeed,
+                    float minLife, float maxLife, const unsigned int* palette, int paletteSize)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            float angle = RandomFloat(0.0f, 6.2831853f);
+            float speed = RandomFloat(minSpeed, maxSpeed);
+            unsigned int color = palette[static_cast<int>(RandomFloat(0.0f, static_cast<float>(paletteSize) - 0.001f))];
+            SpawnParticle(static_cast<float>(x), static_cast<float>(y),
+                          std::cos(angle) * speed, std::sin(angle) * speed,
+                          RandomFloat(minLife, maxLife), color);
+        }
+    }
+}
+
+void SpawnParticle(float x, float y, float vx, float vy, float life, unsigned int rgba)
+{
+    // 环满或超出预算时覆盖最早的粒子
+    if (g_count >= g_budget || g_count == PARTICLE_CAPACITY)
+        DropOldest(1);
+
+    unsigned int slot = (g_head + g_count) & kMask;
+    g_posX[slot] = x;
+    g_posY[slot] = y;
+    g_velX[slot] = vx;
+    g_velY[slot] = vy;
+    g_life[slot] = life;
+    g_lifeScale[slot] = life > 0.0f ? 1.0f / life : 0.0f;
+    g_color[slot] = rgba;
+    g_count++;
+}
+
+void SpawnExplosion(double x, double y)
+{
+    static const unsigned int kPalette[] = {0xFFD040FFu, 0xFF8020FFu, 0xFF3010FFu, 0xFFFFFFFFu};
+    SpawnBurst(x, y, EXPLOSION_PARTICLES, 60.0f, 360.0f, 0.3f, 0.9f, kPalette, 4);
+}
+
+void SpawnHitSparks(double x, double y)
+{
+    static const unsigned int kPalette[] = {0xFFFFA0FFu, 0xFFFFFFFFu};
+    SpawnBurst(x, y, HIT_SPARK_PARTICLES, 100.0f, 250.0f, 0.1f, 0.25f, kPalette, 2);
+}
+
+void UpdateParticles(double deltaTime)
+{
+    if (g_count > g_budget)
+        DropOldest(g_count - g_budget);
+    if (g_count == 0)
+        return;
+
+    // 环可能绕回数组开头：拆成至多两段连续区间
+    float dt = static_cast<float>(deltaTime);
+    unsigned int end = g_head + g_count;
+    if (end <= PARTICLE_CAPACITY)
+        UpdateRange(g_head, end, dt);
+    else
+    {
+        UpdateRange(g_head, PARTICLE_CAPACITY, dt);
+        UpdateRange(0, end - PARTICLE_CAPACITY, dt);
+    }
+
+    // 回收环首已死亡的粒子（寿命相近，大体按生成顺序死亡）
+    while (g_count > 0 && g_life[g_head] <= 0.0f)
+    {
+        g_head = (g_head + 1) & kMask;
+        g_count--;
+    }
+}
+
+void RenderParticles(SDL_Renderer* renderer)
+{
+    if (!renderer)
+        return;
+
+    // 索引是固定的四边形模式，只生成一次（第一次调用时就准备好，避免在第一次爆炸时才分配）
+    if (g_indices.empty())
+    {
+        g_vertices.reserve(static_cast<size_t>(PARTICLE_RENDER_BUDGET) * 4);
+        g_indices.resize(static_cast<size_t>(PARTICLE_RENDER_BUDGET) * 6);
+        for (int q = 0; q < PARTICLE_RENDER_BUDGET; ++q)
+        {
+            int* idx = &g_indices[static_cast<size_t>(q) * 6];
+            idx[0] = q * 4;
+            idx[1] = q * 4 + 1;
+            idx[2] = q * 4 + 2;
+            idx[3] = q * 4;
+            idx[4] = q * 4 + 2;
+            idx[5] = q * 4 + 3;
+        }
+    }
+    if (g_count == 0)
+        return;
+
+    // 超出绘制预算时只绘制最新的粒子
+    unsigned int drawCount = g_count < PARTICLE_RENDER_BUDGET ? g_count : PARTICLE_RENDER_BUDGET;
+    unsigned int first = (g_head + g_count - drawCount) & kMask;
+    const float half = static_cast<float>(PARTICLE_SIZE) * 0.5f;
+
+    g_vertices.clear();
+    for (unsigned int n = 0; n < drawCount; ++n)
+    {
+        unsigned int i = (first + n) & kMask;
+        if (g_life[i] <= 0.0f)
+            continue;
+
+        unsigned int c = g_color[i];
+        float fade = g_life[i] * g_lifeScale[i];  // 随寿命线性淡出
+        SDL_Color color{static_cast<Uint8>(c >> 24), static_cast<Uint8>(c >> 16), static_cast<Uint8>(c >> 8),
+                        static_cast<Uint8>((c & 0xFFu) * fade)};
+        float x = g_posX[i], y = g_posY[i];
+        g_vertices.push_back({{x - half, y - half}, color, {0.0f, 0.0f}});
+        g_vertices.push_back({{x + half, y - half}, color, {0.0f, 0.0f}});
+        g_vertices.push_back({{x + half, y + half}, color, {0.0f, 0.0f}});
+        g_vertices.push_back({{x - half, y + half}, color, {0.0f, 0.0f}});
+    }
+    if (g_vertices.empty())
+        return;
+
+    // 无纹理几何体使用渲染器的混合模式：叠加混合让爆炸更亮
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_ADD);
+    SDL_RenderGeometry(renderer, nullptr, g_vertices.data(), static_cast<int>(g_vertices.size()),
+                       g_indices.data(), static_cast<int>(g_vertices.size() / 4 * 6));
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
+
+void ClearParticles()
+{
+    g_head = 0;
+    g_count = 0;
+}
+
+void SetParticleBudget(int budget)
+{
+    if (budget < 0)
+        budget = 0;
+    if (budget > PARTICLE_CAPACITY)
+        budget = PARTICLE_CAPACITY;
+    g_budget = static_cast<unsigned int>(budget);
+    if (g_count > g_budget)
+        DropOldest(g_count - g_budget);
+}
+
+int GetParticleCount()
+{
+    return static_cast<int>(g_count);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+struct SDL_Renderer;
+
+// ===== 粒子系统（爆炸、命中火花） =====
+// 固定容量的环形缓冲区，数据按字段分开存放（SoA），
+// 更新是对连续 float 数组的向量化循环，绘制是一次 SDL_RenderGeometry 调用；
+// 活跃粒子数超过预算时，最早生成的粒子先被丢弃
+
+// 在指定位置生成一次爆炸（敌机被消灭时）
+void SpawnExplosion(double x, double y);
+
+// 在指定位置生成命中火花（子弹击中但未消灭敌机时）
+void SpawnHitSparks(double x, double y);
+
+// 生成一个粒子（位置、速度、寿命、颜色 0xRRGGBBAA）
+void SpawnParticle(float x, float y, float vx, float vy, float life, unsigned int rgba);
+
+// 更新所有粒子（移动、重力、寿命），并回收环首已死亡的粒子
+void UpdateParticles(double deltaTime);
+
+// 绘制所有粒子（一次绘制调用）
+void RenderParticles(SDL_Renderer* renderer);
+
+// 清空所有粒子
+void ClearParticles();
+
+// 设置活跃粒子数上限（不超过容量），超出部分立即丢弃最早的粒子
+void SetParticleBudget(int budget);
+
+// 当前活跃粒子数（环中的粒子数，含尚未回收的已死亡粒子）
+int GetParticleCount();
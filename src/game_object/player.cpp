@@ -1,6 +1,7 @@
 #include "player.h"
 
 #include "../input/input.h"
+#include "../render/sprite_batch.h"
 #include "../util/config.h"
 #include "../util/util.h"
 
@@ -8,95 +9,176 @@
 
 namespace
 {
-    // 玩家飞机对象（全局单例）
-    Player g_player = {};
-    // 标记玩家是否存在
-    bool g_hasPlayer = false;
+    // 所有玩家飞机对象（固定容量，下标即玩家编号）
+    Player g_players[MAX_PLAYERS] = {};
+    // 当前存在的玩家数量（0 表示玩家已销毁）
+    int g_playerCount = 0;
+    // CreatePlayer 时要创建的玩家数量
+    int g_requestedPlayerCount = 1;
+    // 本机控制的玩家编号
+    int g_localPlayer = 0;
+
+    // 更新单个玩家（移动、边界限制、冷却）
+    // 按输入时间线逐段积分，帧内的短按也能产生对应时长的移动
+    void UpdateOnePlayer(Player& player, double deltaTime)
+    {
+        int segmentCount = GetPlayerInputSegmentCount(player);
+        for (int s = 0; s < segmentCount; ++s)
+        {
+            double end = 1.0;
+            InputSegment segment = GetPlayerInputSegment(player, s, end);
+            double segmentTime = (end - segment.start) * deltaTime;
+
+            // ===== 处理移动输入 =====
+            // 初始化移动方向向量
+            Vector2 direction = {0.0, 0.0};
+
+            if (segment.bits & INPUT_UP)
+                direction.y -= 1.0;
+            if (segment.bits & INPUT_DOWN)
+                direction.y += 1.0;
+            if (segment.bits & INPUT_LEFT)
+                direction.x -= 1.0;
+            if (segment.bits & INPUT_RIGHT)
+                direction.x += 1.0;
+
+            // 正规化方向向量（这样即使斜向移动也是恒定速度）
+            direction = Normalize(direction);
+
+            // 根据方向、速度和该段时长更新位置
+            player.position.x += direction.x * player.attributes.speed * segmentTime;
+            player.position.y += direction.y * player.attributes.speed * segmentTime;
+
+            // ===== 限制玩家在游戏区域内 =====
+            player.position.x = Clamp(player.position.x, 0.0, GAME_WIDTH - player.width);
+            player.position.y = Clamp(player.position.y, 0.0, GAME_HEIGHT - player.height);
+        }
+
+        // ===== 更新射击冷却时间 =====
+        // 冷却允许降到 -deltaTime，UpdateBullets 据此算出本帧内可以开火的时刻
+        player.attributes.bulletCd -= deltaTime;
+        if (player.attributes.bulletCd < -deltaTime)
+            player.attributes.bulletCd = -deltaTime;
+        if (player.missileCd > 0.0)
+            player.missileCd -= deltaTime;
+    }
+}
+
+// 玩家本帧输入的段数
+int GetPlayerInputSegmentCount(const Player& player)
+{
+    return player.inputSegmentCount > 0 ? player.inputSegmentCount : 1;
+}
+
+// 获取玩家本帧的第 index 段输入
+InputSegment GetPlayerInputSegment(const Player& player, int index, double& end)
+{
+    if (player.inputSegmentCount <= 0)
+    {
+        end = 1.0;
+        return {0.0, player.input};
+    }
+    end = (index + 1 < player.inputSegmentCount) ? player.inputTimeline[index + 1].start : 1.0;
+    return player.inputTimeline[index];
+}
+
+// 设置玩家数量
+void SetPlayerCount(int count)
+{
+    g_requestedPlayerCount = static_cast<int>(Clamp(count, 1, MAX_PLAYERS));
+}
+
+// 获取当前玩家数量
+int GetPlayerCount()
+{
+    return g_playerCount;
+}
+
+// 设置本机控制的玩家编号
+void SetLocalPlayerIndex(int index)
+{
+    g_localPlayer = static_cast<int>(Clamp(index, 0, MAX_PLAYERS - 1));
 }
 
 // 初始化玩家
 void CreatePlayer()
 {
-    g_hasPlayer = true;
-    // 玩家出现在屏幕中下方，水平居中
-    g_player.position.x = (GAME_WIDTH - PLAYER_WIDTH) / 2.0;
-    g_player.position.y = GAME_HEIGHT - PLAYER_HEIGHT - 20.0;
-    g_player.width = PLAYER_WIDTH;
-    g_player.height = PLAYER_HEIGHT;
-    // 初始化属性
-    g_player.attributes.health = PLAYER_INITIAL_HEALTH;
-    g_player.attributes.score = 0;
-    g_player.attributes.speed = PLAYER_SPEED;
-    g_player.attributes.maxBulletCd = PLAYER_BULLET_COOLDOWN;
-    g_player.attributes.bulletCd = 0.0;
+    g_playerCount = g_requestedPlayerCount;
+    for (int i = 0; i < g_playerCount; ++i)
+    {
+        Player& player = g_players[i];
+        // 玩家出现在屏幕下方，沿水平方向均分（单人时即居中）
+        player.position.x = GAME_WIDTH * (i + 1) / (g_playerCount + 1.0) - PLAYER_WIDTH / 2.0;
+        player.position.y = GAME_HEIGHT - PLAYER_HEIGHT - 20.0;
+        player.width = PLAYER_WIDTH;
+        player.height = PLAYER_HEIGHT;
+        // 初始化属性
+        player.attributes.health = PLAYER_INITIAL_HEALTH;
+        player.attributes.score = 0;
+        player.attributes.speed = PLAYER_SPEED;
+        player.attributes.maxBulletCd = PLAYER_BULLET_COOLDOWN;
+        player.attributes.bulletCd = 0.0;
+        player.missileCd = 0.0;
+        player.input = 0;
+        player.inputSegmentCount = 0;
+    }
 }
 
-// 获取玩家对象指针
+// 获取本机玩家对象指针
 Player* GetPlayer()
 {
-    return g_hasPlayer ? &g_player : nullptr;
+    return GetPlayerByIndex(g_localPlayer);
 }
 
-// 更新玩家状态（每帧调用）
-void UpdatePlayer(double deltaTime)
+// 按编号获取玩家对象指针
+Player* GetPlayerByIndex(int index)
 {
-    if (!g_hasPlayer)
-        return;
+    if (index < 0 || index >= g_playerCount)
+        return nullptr;
+    return &g_players[index];
+}
 
-    // ===== 处理移动输入 =====
-    // 初始化移动方向向量
-    Vector2 direction = {0.0, 0.0};
-    
-    // 检查上箭头或 W 键
-    if (IsKeyDown(SDL_SCANCODE_W) || IsKeyDown(SDL_SCANCODE_UP))
-        direction.y -= 1.0;
-    // 检查下箭头或 S 键
-    if (IsKeyDown(SDL_SCANCODE_S) || IsKeyDown(SDL_SCANCODE_DOWN))
-        direction.y += 1.0;
-    // 检查左箭头或 A 键
-    if (IsKeyDown(SDL_SCANCODE_A) || IsKeyDown(SDL_SCANCODE_LEFT))
-        direction.x -= 1.0;
-    // 检查右箭头或 D 键
-    if (IsKeyDown(SDL_SCANCODE_D) || IsKeyDown(SDL_SCANCODE_RIGHT))
-        direction.x += 1.0;
-
-    // 正规化方向向量（这样即使斜向移动也是恒定速度）
-    direction = Normalize(direction);
-
-    // 根据方向、速度和 deltaTime 更新位置
-    g_player.position.x += direction.x * g_player.attributes.speed * deltaTime;
-    g_player.position.y += direction.y * g_player.attributes.speed * deltaTime;
-
-    // ===== 限制玩家在游戏区域内 =====
-    g_player.position.x = Clamp(g_player.position.x, 0.0, GAME_WIDTH - g_player.width);
-    g_player.position.y = Clamp(g_player.position.y, 0.0, GAME_HEIGHT - g_player.height);
-
-    // ===== 更新射击冷却时间 =====
-    if (g_player.attributes.bulletCd > 0.0)
-        g_player.attributes.bulletCd -= deltaTime;  // 冷却递减
+// 更新所有玩家状态（每帧调用）
+void UpdatePlayer(double deltaTime)
+{
+    for (int i = 0; i < g_playerCount; ++i)
+        UpdateOnePlayer(g_players[i], deltaTime);
 }
 
-// 渲染玩家
+// 渲染所有玩家
 void RenderPlayer(SDL_Renderer* renderer)
 {
-    if (!g_hasPlayer || !renderer)
+    if (!renderer)
         return;
 
-    // 转换为 SDL 矩形结构
-    SDL_Rect r;
-    r.x = static_cast<int>(g_player.position.x);
-    r.y = static_cast<int>(g_player.position.y);
-    r.w = static_cast<int>(g_player.width);
-    r.h = static_cast<int>(g_player.height);
-
-    // 设置渲染颜色为蓝色
-    SDL_SetRenderDrawColor(renderer, COLOR_BLUE.r, COLOR_BLUE.g, COLOR_BLUE.b, 255);
-    // 绘制填充矩形
-    SDL_RenderFillRect(renderer, &r);
+    for (int i = 0; i < g_playerCount; ++i)
+    {
+        const Player& player = g_players[i];
+
+        // 图集可用时加入精灵批次，否则退回纯色矩形
+        if (SpriteBatchIsActive())
+        {
+            SpriteBatchAdd(i == 0 ? SPRITE_PLAYER : SPRITE_PLAYER2, player.position.x, player.position.y);
+            continue;
+        }
+
+        // 转换为 SDL 矩形结构
+        SDL_Rect r;
+        r.x = static_cast<int>(player.position.x);
+        r.y = static_cast<int>(player.position.y);
+        r.w = static_cast<int>(player.width);
+        r.h = static_cast<int>(player.height);
+
+        // 玩家 1 为蓝色，玩家 2 为绿色
+        const Color& color = (i == 0) ? COLOR_BLUE : COLOR_GREEN;
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
+        // 绘制填充矩形
+        SDL_RenderFillRect(renderer, &r);
+    }
 }
 
 // 销毁玩家
 void DestroyPlayer()
 {
-    g_hasPlayer = false;
+    g_playerCount = 0;
 }
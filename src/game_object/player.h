@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../util/config.h"
 #include "../util/type.h"
 
 struct SDL_Renderer;
@@ -11,22 +12,45 @@ struct Player
     double width;           // 宽度
     double height;          // 高度
     Attribute attributes;   // 属性（生命，分数，速度等）
+    double missileCd;       // 追踪导弹的剩余冷却时间（秒）
+    unsigned int input;     // 本帧输入位掩码（InputBits 组合）
+    // 本帧输入时间线（本机玩家由按键事件生成；数量为 0 时整帧使用 input）
+    InputSegment inputTimeline[INPUT_MAX_SEGMENTS];
+    int inputSegmentCount;
 };
 
+// 获取玩家本帧的第 index 段输入，end 返回该段的结束位置（帧内比例）
+InputSegment GetPlayerInputSegment(const Player& player, int index, double& end);
+
+// 玩家本帧输入的段数（至少为 1）
+int GetPlayerInputSegmentCount(const Player& player);
+
 // ===== 玩家模块 API =====
 
-// 初始化并创建玩家
-// 玩家会在屏幕中下方居中
+// 设置玩家数量（1 = 单机，2 = 联机），在下一次 CreatePlayer 时生效
+void SetPlayerCount(int count);
+
+// 获取当前存在的玩家数量（0 表示玩家已销毁）
+int GetPlayerCount();
+
+// 设置本机控制的玩家编号（联机客户端为 1）
+void SetLocalPlayerIndex(int index);
+
+// 初始化并创建所有玩家
+// 玩家会在屏幕下方沿水平方向均匀排开
 void CreatePlayer();
 
-// 获取玩家对象指针
+// 获取本机玩家对象指针
 // 返回 nullptr 表示玩家已销毁
 Player* GetPlayer();
 
-// 更新玩家状态（移动、射击、冷却）
+// 按编号获取玩家对象指针（越界或已销毁时返回 nullptr）
+Player* GetPlayerByIndex(int index);
+
+// 更新所有玩家状态（根据各自的 input 移动、冷却）
 void UpdatePlayer(double deltaTime);
 
-// 渲染玩家（绘制蓝色矩形）
+// 渲染所有玩家（玩家 1 蓝色矩形，玩家 2 绿色矩形）
 void RenderPlayer(SDL_Renderer* renderer);
 
 // 销毁玩家对象
@@ -0,0 +1,218 @@
+#include "spatial_index.h"
+
+#include "boss.h"
+#include "enemy.h"
+
+#include "../util/config.h"
+#include "../util/util.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    const int kColumns = (GAME_WIDTH + SPATIAL_CELL_SIZE - 1) / SPATIAL_CELL_SIZE;
+    const int kRows = (GAME_HEIGHT + SPATIAL_CELL_SIZE - 1) / SPATIAL_CELL_SIZE;
+    const double kFar = 1e30;
+
+    // 按格子排好序的目标
+    std::vector<SpatialTarget> g_targets;
+    // 格子 c 的目标位于 g_targets[g_cellStart[c], g_cellStart[c + 1])
+    int g_cellStart[kColumns * kRows + 1] = {};
+
+    // 重建时的临时数据（保留容量，稳定运行后不再分配）
+    std::vector<SpatialTarget> g_unsorted;
+    std::vector<int> g_cellOf;
+    int g_cursor[kColumns * kRows] = {};
+
+    // 屏幕外的目标（刚生成的敌机、入场中的 Boss）归入边缘格子，距离仍按真实位置计算
+    int ColumnOf(double x)
+    {
+        return static_cast<int>(Clamp(x / SPATIAL_CELL_SIZE, 0.0, kColumns - 1.0));
+    }
+
+    int RowOf(double y)
+    {
+        return static_cast<int>(Clamp(y / SPATIAL_CELL_SIZE, 0.0, kRows - 1.0));
+    }
+
+    double DistanceSq(Vector2 a, Vector2 b)
+    {
+        double dx = a.x - b.x;
+        double dy = a.y - b.y;
+        return dx * dx + dy * dy;
+    }
+
+    // 插入排序维护前 k 近的结果（k 很小，比堆更快）
+    void InsertNearest(SpatialHit* out, int& found, int k, int target, double distanceSq)
+    {
+        if (found == k && distanceSq >= out[k - 1].distanceSq)
+            return;
+        int i = found < k ? found++ : k - 1;
+        while (i > 0 && out[i - 1].distanceSq > distanceSq)
+        {
+            out[i] = out[i - 1];
+            --i;
+        }
+        out[i] = {target, distanceSq};
+    }
+
+    void VisitCell(int cell, Vector2 position, SpatialHit* out, int& found, int k)
+    {
+        for (int i = g_cellStart[cell]; i < g_cellStart[cell + 1]; ++i)
+            InsertNearest(out, found, k, i, DistanceSq(g_targets[i].center, position));
+    }
+
+    // 已搜索的格子块 [x0, x1] × [y0, y1] 之外的目标到查询点的最小可能距离
+    // （块已经到达网格边缘的方向上没有未搜索的格子）
+    double UnvisitedBound(Vector2 position, int x0, int x1, int y0, int y1)
+    {
+        double bound = kFar;
+        if (x0 > 0)
+            bound = std::min(bound, position.x - x0 * static_cast<double>(SPATIAL_CELL_SIZE));
+        if (x1 < kColumns - 1)
+            bound = std::min(bound, (x1 + 1) * static_cast<double>(SPATIAL_CELL_SIZE) - position.x);
+        if (y0 > 0)
+            bound = std::min(bound, position.y - y0 * static_cast<double>(SPATIAL_CELL_SIZE));
+        if (y1 < kRows - 1)
+            bound = std::min(bound, (y1 + 1) * static_cast<double>(SPATIAL_CELL_SIZE) - position.y);
+        return std::max(bound, 0.0);
+    }
+}
+
+void SpatialIndexBuild()
+{
+    // ===== 收集目标 =====
+    g_unsorted.clear();
+    for (int type = 0; type < ENEMY_TYPE_COUNT; ++type)
+    {
+        const std::vector<Enemy>& enemies = GetEnemyBatch(static_cast<EnemyType>(type));
+        for (size_t i = 0; i < enemies.size(); ++i)
+        {
+            const Enemy& e = enemies[i];
+            g_unsorted.push_back({{e.position.x + e.width / 2.0, e.position.y + e.height / 2.0},
+                                  SPATIAL_TARGET_ENEMY, static_cast<int>(i), -1, type});
+        }
+    }
+    const std::vector<Boss>& bosses = GetBosses();
+    for (size_t b = 0; b < bosses.size(); ++b)
+    {
+        for (int p = 0; p < bosses[b].partCount; ++p)
+        {
+            const BossPart& part = bosses[b].parts[p];
+            if (part.alive)
+                g_unsorted.push_back({GetBossPartCenter(part), SPATIAL_TARGET_BOSS_PART, static_cast<int>(b), p, -1});
+        }
+    }
+
+    // ===== 按格子计数排序 =====
+    const int count = static_cast<int>(g_unsorted.size());
+    g_cellOf.resize(count);
+    std::fill(g_cellStart, g_cellStart + kColumns * kRows + 1, 0);
+    for (int i = 0; i < count; ++i)
+    {
+        Vector2 c = g_unsorted[i].center;
+        g_cellOf[i] = RowOf(c.y) * kColumns + ColumnOf(c.x);
+        g_cellStart[g_cellOf[i] + 1]++;
+    }
+    for (int c = 0; c < kColumns * kRows; ++c)
+    {
+        g_cellStart[c + 1] += g_cellStart[c];
+        g_cursor[c] = g_cellStart[c];
+    }
+    g_targets.resize(count);
+    for (int i = 0; i < count; ++i)
+        g_targets[g_cursor[g_cellOf[i]]++] = g_unsorted[i];
+}
+
+void SpatialIndexClear()
+{
+    const size_t capacity = ENEMY_CAPACITY + BOSS_MAX_COUNT * BOSS_MAX_PARTS;
+    g_targets.clear();
+    g_unsorted.clear();
+    g_cellOf.clear();
+    g_targets.reserve(capacity);
+    g_unsorted.reserve(capacity);
+    g_cellOf.reserve(capacity);
+    std::fill(g_cellStart, g_cellStart + kColumns * kRows + 1, 0);
+}
+
+int SpatialQueryNearest(Vector2 position, int k, SpatialHit* out)
+{
+    k = std::min(k, static_cast<int>(g_targets.size()));
+    if (k <= 0)
+        return 0;
+
+    int found = 0;
+    // 目标很少时大部分格子是空的，直接扫描连续存放的全部目标比逐圈扩展更快
+    if (static_cast<int>(g_targets.size()) <= SPATIAL_LINEAR_SCAN_MAX)
+    {
+        for (int i = 0; i < static_cast<int>(g_targets.size()); ++i)
+            InsertNearest(out, found, k, i, DistanceSq(g_targets[i].center, position));
+        return found;
+    }
+
+    int cx = ColumnOf(position.x);
+    int cy = RowOf(position.y);
+    int maxRing = std::max(std::max(cx, kColumns - 1 - cx), std::max(cy, kRows - 1 - cy));
+    for (int r = 0; r <= maxRing; ++r)
+    {
+        // 第 r 圈：切比雪夫距离恰好为 r 的格子（首尾两行整行，中间各行只有左右两端）
+        int x0 = cx - r, x1 = cx + r, y0 = cy - r, y1 = cy + r;
+        for (int y = std::max(y0, 0); y <= std::min(y1, kRows - 1); ++y)
+        {
+            int step = (y == y0 || y == y1) ? 1 : x1 - x0;
+            for (int x = x0; x <= x1; x += step)
+            {
+                if (x >= 0 && x < kColumns)
+                    VisitCell(y * kColumns + x, position, out, found, k);
+            }
+        }
+
+        // 外面的格子不可能有更近的目标时停止
+        if (found == k)
+        {
+            double bound = UnvisitedBound(position, std::max(x0, 0), std::min(x1, kColumns - 1), std::max(y0, 0),
+                                          std::min(y1, kRows - 1));
+            if (out[k - 1].distanceSq <= bound * bound)
+                break;
+        }
+    }
+    return found;
+}
+
+int SpatialQueryRadius(Vector2 position, double radius, SpatialHit* out, int capacity)
+{
+    if (radius < 0.0 || g_targets.empty())
+        return 0;
+
+    int x0 = ColumnOf(position.x - radius), x1 = ColumnOf(position.x + radius);
+    int y0 = RowOf(position.y - radius), y1 = RowOf(position.y + radius);
+    double radiusSq = radius * radius;
+    int total = 0;
+    for (int y = y0; y <= y1; ++y)
+    {
+        // 同一行相邻格子的目标在数组中也相邻，整行一次遍历
+        int rowCell = y * kColumns;
+        for (int i = g_cellStart[rowCell + x0]; i < g_cellStart[rowCell + x1 + 1]; ++i)
+        {
+            double distanceSq = DistanceSq(g_targets[i].center, position);
+            if (distanceSq > radiusSq)
+                continue;
+            if (total < capacity)
+                out[total] = {i, distanceSq};
+            total++;
+        }
+    }
+    return total;
+}
+
+const SpatialTarget& GetSpatialTarget(int target)
+{
+    return g_targets[target];
+}
+
+int GetSpatialTargetCount()
+{
+    return static_cast<int>(g_targets.size());
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../util/type.h"
+
+// ===== 目标空间索引 =====
+// 每个 tick 在敌机和 Boss 更新之后，把所有敌机中心和 Boss 存活部件的中心按均匀网格做一次计数排序：
+// 同一格子的目标在数组中连续存放（格子 c 的目标为 [cellStart[c], cellStart[c + 1])），重建是 O(N)。
+// 最近邻查询从查询点所在格子向外一圈圈扩展，当前第 k 近的距离不超过下一圈的最近可能距离时停止；
+// 半径查询只遍历与查询圆包围盒相交的格子。导弹制导、辅助瞄准等任何系统都可以使用。
+//
+// 下标只在本 tick 的碰撞检测之前有效（碰撞会删除敌机和部件，列表下标随之变化）
+
+// 目标类型
+enum SpatialTargetKind
+{
+    SPATIAL_TARGET_ENEMY = 0,   // 敌机：enemyType 为敌机类型，index 为 GetEnemyBatch(enemyType) 中的下标
+    SPATIAL_TARGET_BOSS_PART    // Boss 部件：index 为 GetBosses() 中的下标，part 为部件下标
+};
+
+// 索引中的一个目标
+struct SpatialTarget
+{
+    Vector2 center;
+    int kind;
+    int index;
+    int part;       // Boss 部件下标（敌机为 -1）
+    int enemyType;  // 敌机类型 EnemyType（Boss 部件为 -1）
+};
+
+// 查询结果：目标在索引中的编号（GetSpatialTarget 的参数）和到查询点距离的平方
+struct SpatialHit
+{
+    int target;
+    double distanceSq;
+};
+
+// 按当前的敌机和 Boss 重建索引（每个 tick 在 UpdateEnemies/UpdateBosses 之后调用）
+void SpatialIndexBuild();
+
+// 清空索引（重置游戏时调用，之后的查询都返回 0 个结果）
+void SpatialIndexClear();
+
+// 离 position 最近的至多 k 个目标，按距离从近到远写入 out，返回个数
+int SpatialQueryNearest(Vector2 position, int k, SpatialHit* out);
+
+// 与 position 距离不超过 radius 的所有目标（顺序不固定），最多写入 capacity 个，
+// 返回满足条件的总数（可能大于 capacity）
+int SpatialQueryRadius(Vector2 position, double radius, SpatialHit* out, int capacity);
+
+// 索引中的目标（编号越界时行为未定义）
+const SpatialTarget& GetSpatialTarget(int target);
+
+// 索引中的目标数量
+int GetSpatialTargetCount();
@@ -1,5 +1,7 @@
 #include "input.h"
 
+#include "../util/config.h"
+
 #include <array>
 
 namespace
@@ -13,12 +15,74 @@ namespace
     // 当前鼠标坐标
     int g_mouseX = 0;
     int g_mouseY = 0;
+
+    // 本帧按键事件的环形队列（固定容量，不分配内存）
+    std::array<InputEvent, INPUT_EVENT_CAPACITY> g_events = {};
+    int g_eventHead = 0;       // 最早事件的下标
+    int g_eventCount = 0;      // 当前事件数量
+    int g_droppedEvents = 0;   // 启动以来被丢弃的事件总数
+
+    // 本帧开始时的键盘状态（用于重放事件生成时间线）
+    std::array<bool, SDL_NUM_SCANCODES> g_frameStartKeys = {};
+
+    // 本帧的时间窗口 [start, end]（毫秒）
+    Uint32 g_windowStartMs = 0;
+    Uint32 g_windowEndMs = 0;
+    bool g_hasWindow = false;
+
+    // 根据一组按键状态计算输入位掩码
+    unsigned int BitsFromKeys(const std::array<bool, SDL_NUM_SCANCODES>& keys)
+    {
+        unsigned int bits = 0;
+        if (keys[SDL_SCANCODE_W] || keys[SDL_SCANCODE_UP])
+            bits |= INPUT_UP;
+        if (keys[SDL_SCANCODE_S] || keys[SDL_SCANCODE_DOWN])
+            bits |= INPUT_DOWN;
+        if (keys[SDL_SCANCODE_A] || keys[SDL_SCANCODE_LEFT])
+            bits |= INPUT_LEFT;
+        if (keys[SDL_SCANCODE_D] || keys[SDL_SCANCODE_RIGHT])
+            bits |= INPUT_RIGHT;
+        if (keys[SDL_SCANCODE_SPACE])
+            bits |= INPUT_FIRE;
+        return bits;
+    }
+
+    // 把事件追加到队列末尾，队列满时覆盖最早的事件
+    void PushEvent(Uint32 timestampMs, SDL_Scancode key, bool pressed)
+    {
+        if (g_eventCount == INPUT_EVENT_CAPACITY)
+        {
+            g_eventHead = (g_eventHead + 1) % INPUT_EVENT_CAPACITY;
+            g_eventCount--;
+            g_droppedEvents++;
+        }
+        int slot = (g_eventHead + g_eventCount) % INPUT_EVENT_CAPACITY;
+        g_events[slot] = {timestampMs, key, pressed};
+        g_eventCount++;
+    }
+
+    // 事件在本帧时间窗口中的位置（0~1）
+    double EventFraction(const InputEvent& e)
+    {
+        if (g_windowEndMs <= g_windowStartMs)
+            return 1.0;
+        double f = static_cast<double>(static_cast<Sint32>(e.timestampMs - g_windowStartMs)) /
+                   (g_windowEndMs - g_windowStartMs);
+        return f < 0.0 ? 0.0 : (f > 1.0 ? 1.0 : f);
+    }
 }
 
-// 输入系统初始化（目前预留用于未来的逻辑）
+// 每帧开始：清空事件队列，记录帧初键盘状态与时间窗口
 void InputBeginFrame()
 {
-    // 预留给未来的每帧逻辑
+    g_eventHead = 0;
+    g_eventCount = 0;
+    g_frameStartKeys = g_keys;
+
+    Uint32 now = SDL_GetTicks();
+    g_windowStartMs = g_hasWindow ? g_windowEndMs : now;
+    g_windowEndMs = now;
+    g_hasWindow = true;
 }
 
 // 处理 SDL 事件并更新输入状态
@@ -26,14 +90,21 @@ void InputProcessEvent(const SDL_Event& e)
 {
     switch (e.type)
     {
-    case SDL_KEYDOWN:  // 键盘按下
+    case SDL_KEYDOWN:  // 键盘按下（按住时的自动重复事件不进入队列）
         if (e.key.keysym.scancode >= 0 && e.key.keysym.scancode < SDL_NUM_SCANCODES)
+        {
             g_keys[e.key.keysym.scancode] = true;
+            if (!e.key.repeat)
+                PushEvent(e.key.timestamp, e.key.keysym.scancode, true);
+        }
         break;
         
     case SDL_KEYUP:  // 键盘释放
         if (e.key.keysym.scancode >= 0 && e.key.keysym.scancode < SDL_NUM_SCANCODES)
+        {
             g_keys[e.key.keysym.scancode] = false;
+            PushEvent(e.key.timestamp, e.key.keysym.scancode, false);
+        }
         break;
         
     case SDL_MOUSEBUTTONDOWN:  // 鼠标按钮按下
@@ -78,3 +149,72 @@ void GetMousePos(int& x, int& y)
     x = g_mouseX;
     y = g_mouseY;
 }
+
+// 将键盘状态汇总为位掩码（WASD/方向键移动，空格射击）
+unsigned int InputSampleBits()
+{
+    return BitsFromKeys(g_keys);
+}
+
+// 本帧事件数量
+int InputGetEventCount()
+{
+    return g_eventCount;
+}
+
+// 获取本帧第 index 个事件
+const InputEvent& InputGetEvent(int index)
+{
+    return g_events[(g_eventHead + index) % INPUT_EVENT_CAPACITY];
+}
+
+// 启动以来丢弃的事件总数
+int InputGetDroppedEventCount()
+{
+    return g_droppedEvents;
+}
+
+// 从帧初状态开始按时间顺序重放事件，累积出现过的所有位
+unsigned int InputGetFrameBits()
+{
+    std::array<bool, SDL_NUM_SCANCODES> keys = g_frameStartKeys;
+    unsigned int bits = BitsFromKeys(keys) | InputSampleBits();
+    for (int i = 0; i < g_eventCount; ++i)
+    {
+        const InputEvent& e = InputGetEvent(i);
+        keys[e.key] = e.pressed;
+        bits |= BitsFromKeys(keys);
+    }
+    return bits;
+}
+
+// 从帧初状态开始按时间顺序重放事件，每当位掩码变化就开始新的一段
+int InputGetTimeline(InputSegment* out, int capacity)
+{
+    if (capacity <= 0)
+        return 0;
+
+    std::array<bool, SDL_NUM_SCANCODES> keys = g_frameStartKeys;
+    out[0] = {0.0, BitsFromKeys(keys)};
+    int count = 1;
+
+    for (int i = 0; i < g_eventCount; ++i)
+    {
+        const InputEvent& e = InputGetEvent(i);
+        keys[e.key] = e.pressed;
+        unsigned int bits = BitsFromKeys(keys);
+        if (bits == out[count - 1].bits)
+            continue;
+
+        double start = EventFraction(e);
+        // 同一时刻的多次变化、或段数已满时，只更新最后一段
+        if (start <= out[count - 1].start || count == capacity)
+            out[count - 1].bits = bits;
+        else
+            out[count++] = {start, bits};
+    }
+
+    // 有事件被丢弃时，保证最后一段与当前键盘状态一致
+    out[count - 1].bits = InputSampleBits();
+    return count;
+}
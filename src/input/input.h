@@ -1,8 +1,29 @@
 #pragma once
 
+#include "../util/type.h"
+
 #include <SDL.h>
 
-// 输入系统初始化（在每帧开始调用）
+// 玩家操作的位掩码（本地键盘与联机输入包都使用这一格式）
+enum InputBits : unsigned int
+{
+    INPUT_UP = 1u << 0,     // 向上移动
+    INPUT_DOWN = 1u << 1,   // 向下移动
+    INPUT_LEFT = 1u << 2,   // 向左移动
+    INPUT_RIGHT = 1u << 3,  // 向右移动
+    INPUT_FIRE = 1u << 4    // 射击
+};
+
+// 一个带时间戳的按键事件
+struct InputEvent
+{
+    Uint32 timestampMs;    // SDL 事件时间戳（毫秒）
+    SDL_Scancode key;      // 扫描码
+    bool pressed;          // true = 按下，false = 释放
+};
+
+// 输入系统每帧开始（在轮询事件之前调用）
+// 清空本帧事件队列，并把上一帧结束到现在作为本帧的时间窗口
 void InputBeginFrame();
 
 // 处理单个 SDL 事件（键盘、鼠标、窗口事件等）
@@ -16,3 +37,25 @@ bool IsMouseDown(Uint8 button);
 
 // 获取当前鼠标坐标（以引用参数方式返回）
 void GetMousePos(int& x, int& y);
+
+// 将当前键盘状态转换为 InputBits 位掩码
+unsigned int InputSampleBits();
+
+// ===== 带时间戳的事件队列 =====
+// 比一帧更短的点按也会被记录下来，游戏逻辑可以在帧内的真实时刻处理它
+
+// 本帧记录的按键事件数量（按时间先后排列）
+int InputGetEventCount();
+
+// 获取本帧第 index 个按键事件
+const InputEvent& InputGetEvent(int index);
+
+// 启动以来因队列已满而丢弃的事件总数（HUD 在不为 0 时显示）
+int InputGetDroppedEventCount();
+
+// 本帧内任意时刻有效过的输入位（短于一帧的点按也包含在内；联机客户端发送给主机）
+unsigned int InputGetFrameBits();
+
+// 将本帧的按键事件转换为输入时间线（段按 start 升序，第一段从 0 开始）
+// 返回写入的段数；段数超过 capacity 时后续变化合并到最后一段
+int InputGetTimeline(InputSegment* out, int capacity);
@@ -0,0 +1,692 @@
+#include "level.h"
+
+#include "../game_object/boss.h"
+#include "../game_object/enemy.h"
+#include "../game_object/flow_field.h"
+#include "../game_object/player.h"
+#include "../util/config.h"
+#include "../util/log.h"
+#include "../util/util.h"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    static_assert(LEVEL_CHUNK_BYTES % 4096 == 0, "Level chunks must start on page boundaries");
+    static_assert(4 + LEVEL_CHUNK_MAX_SPAWNS * 12 + LEVEL_CHUNK_MAX_OBSTACLES * 16 <= LEVEL_CHUNK_BYTES,
+                  "Level chunk records must fit in one chunk");
+
+    const uint32_t kVersion = 1;
+    // 屏幕最多同时跨越的块数
+    const int kVisibleChunks = (GAME_HEIGHT + LEVEL_CHUNK_HEIGHT - 1) / LEVEL_CHUNK_HEIGHT + 1;
+    static_assert(kVisibleChunks + LEVEL_LOOKAHEAD_CHUNKS <= LEVEL_CHUNK_SLOTS,
+                  "Resident slots must cover the screen plus the lookahead");
+    const int kMaxVisibleObstacles = kVisibleChunks * LEVEL_CHUNK_MAX_OBSTACLES;
+    const int kFlowColumns = (GAME_WIDTH + FLOW_CELL_SIZE - 1) / FLOW_CELL_SIZE;
+    const int kFlowRows = (GAME_HEIGHT + FLOW_CELL_SIZE - 1) / FLOW_CELL_SIZE;
+
+    // 解码后的数据块（距离都换算成从关卡起点算起的卷轴距离）
+    struct LevelSpawn
+    {
+        double x;
+        double distance;
+        int kind;
+    };
+
+    struct LevelObstacle
+    {
+        double x;
+        double distance;    // 下边缘
+        double width;
+        double height;
+    };
+
+    struct LevelChunk
+    {
+        int spawnCount;
+        int obstacleCount;
+        LevelSpawn spawns[LEVEL_CHUNK_MAX_SPAWNS];      // 按距离从近到远排序
+        LevelObstacle obstacles[LEVEL_CHUNK_MAX_OBSTACLES];
+    };
+
+    // 槽位状态：游戏线程只在非 LOADING 时改写槽位，后台线程只处理 LOADING 的槽位
+    enum SlotState
+    {
+        SLOT_EMPTY = 0,
+        SLOT_LOADING,
+        SLOT_READY
+    };
+
+    struct ChunkSlot
+    {
+        std::atomic<int> state{SLOT_EMPTY};
+        int chunk = -1;
+        LevelChunk data;
+    };
+
+    // 块号 k 固定放在槽位 k % LEVEL_CHUNK_SLOTS
+    ChunkSlot g_slots[LEVEL_CHUNK_SLOTS];
+
+    // ===== 文件映射 =====
+    const unsigned char* g_map = nullptr;
+    size_t g_mapSize = 0;
+#ifdef _WIN32
+    HANDLE g_fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE g_mappingHandle = nullptr;
+#endif
+
+    // ===== 后台加载线程 =====
+    SDL_Thread* g_loader = nullptr;
+    SDL_sem* g_wake = nullptr;          // 每次请求（或停止）发一次信号
+    std::atomic<bool> g_stopping{false};
+    std::atomic<int> g_loaded{0};
+
+    // ===== 以下只在游戏线程访问 =====
+    bool g_open = false;
+    int g_chunkCount = 0;
+    double g_distance = 0.0;
+    double g_scrollSpeed = LEVEL_SCROLL_SPEED;
+    // 下一个要生成的出现点
+    int g_spawnChunk = 0;
+    int g_spawnIndex = 0;
+    int g_lateTicks = 0;
+    bool g_completeLogged = false;
+    // 本 tick 屏幕内的障碍（屏幕坐标）
+    Rect g_visible[kMaxVisibleObstacles];
+    int g_visibleCount = 0;
+    SDL_Rect g_drawRects[kMaxVisibleObstacles];
+    // 当前在流场中标记为障碍的格子
+    std::array<bool, kFlowColumns * kFlowRows> g_blocked = {};
+
+    uint32_t ReadU32(const unsigned char* p)
+    {
+        return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 | static_cast<uint32_t>(p[2]) << 16 |
+               static_cast<uint32_t>(p[3]) << 24;
+    }
+
+    int ReadU16(const unsigned char* p)
+    {
+        return p[0] | p[1] << 8;
+    }
+
+    double ReadF32(const unsigned char* p)
+    {
+        uint32_t bits = ReadU32(p);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return std::isfinite(value) ? value : 0.0;
+    }
+
+    void PutU16(unsigned char* p, unsigned int value)
+    {
+        p[0] = static_cast<unsigned char>(value);
+        p[1] = static_cast<unsigned char>(value >> 8);
+    }
+
+    void PutU32(unsigned char* p, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+            p[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+
+    void PutF32(unsigned char* p, double value)
+    {
+        float f = static_cast<float>(value);
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        PutU32(p, bits);
+    }
+
+    bool MapFile(const char* path)
+    {
+#ifdef _WIN32
+        g_fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                   FILE_FLAG_RANDOM_ACCESS, nullptr);
+        if (g_fileHandle == INVALID_HANDLE_VALUE)
+            return false;
+        LARGE_INTEGER size = {};
+        GetFileSizeEx(g_fileHandle, &size);
+        g_mappingHandle = size.QuadPart > 0 ? CreateFileMappingA(g_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr)
+                                            : nullptr;
+        void* view = g_mappingHandle ? MapViewOfFile(g_mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!view)
+        {
+            if (g_mappingHandle)
+                CloseHandle(g_mappingHandle);
+            CloseHandle(g_fileHandle);
+            g_mappingHandle = nullptr;
+            g_fileHandle = INVALID_HANDLE_VALUE;
+            return false;
+        }
+        g_map = static_cast<const unsigned char*>(view);
+        g_mapSize = static_cast<size_t>(size.QuadPart);
+        return true;
+#else
+        int fd = open(path, O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat info = {};
+        void* view = MAP_FAILED;
+        if (fstat(fd, &info) == 0 && info.st_size > 0)
+            view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);  // 映射建立后不再需要文件描述符
+        if (view == MAP_FAILED)
+            return false;
+        g_map = static_cast<const unsigned char*>(view);
+        g_mapSize = static_cast<size_t>(info.st_size);
+        return true;
+#endif
+    }
+
+    void UnmapFile()
+    {
+        if (!g_map)
+            return;
+#ifdef _WIN32
+        UnmapViewOfFile(g_map);
+        CloseHandle(g_mappingHandle);
+        CloseHandle(g_fileHandle);
+        g_mappingHandle = nullptr;
+        g_fileHandle = INVALID_HANDLE_VALUE;
+#else
+        munmap(const_cast<unsigned char*>(g_map), g_mapSize);
+#endif
+        g_map = nullptr;
+        g_mapSize = 0;
+    }
+
+    // 解码完的块不再需要映射的页面：POSIX 上立即归还（只读映射的页面随时可以从文件重新读入），
+    // Windows 上由系统按工作集回收
+    void ReleasePages(const unsigned char* data, size_t size)
+    {
+#ifdef _WIN32
+        (void)data;
+        (void)size;
+#else
+        madvise(const_cast<unsigned char*>(data), size, MADV_DONTNEED);
+#endif
+    }
+
+    // 后台线程：从映射中解码第 chunk 块（数量越界的块按空块处理）
+    void DecodeChunk(int chunk, LevelChunk& out)
+    {
+        const unsigned char* data = g_map + static_cast<size_t>(chunk + 1) * LEVEL_CHUNK_BYTES;
+        out.spawnCount = ReadU16(data);
+        out.obstacleCount = ReadU16(data + 2);
+        if (out.spawnCount > LEVEL_CHUNK_MAX_SPAWNS || out.obstacleCount > LEVEL_CHUNK_MAX_OBSTACLES)
+        {
+            SDL_Log("Level: chunk %d is corrupt (%d spawns, %d obstacles)", chunk, out.spawnCount, out.obstacleCount);
+            out.spawnCount = 0;
+            out.obstacleCount = 0;
+        }
+
+        const double base = static_cast<double>(chunk) * LEVEL_CHUNK_HEIGHT;
+        const unsigned char* p = data + 4;
+        for (int i = 0; i < out.spawnCount; ++i, p += 12)
+        {
+            out.spawns[i].x = ReadF32(p);
+            out.spawns[i].distance = base + Clamp(ReadF32(p + 4), 0.0, static_cast<double>(LEVEL_CHUNK_HEIGHT));
+            out.spawns[i].kind = static_cast<int>(ReadU32(p + 8));
+        }
+        std::sort(out.spawns, out.spawns + out.spawnCount,
+                  [](const LevelSpawn& a, const LevelSpawn& b) { return a.distance < b.distance; });
+        for (int i = 0; i < out.obstacleCount; ++i, p += 16)
+        {
+            LevelObstacle& o = out.obstacles[i];
+            o.x = ReadF32(p);
+            o.distance = base + ReadF32(p + 4);
+            o.width = std::max(0.0, ReadF32(p + 8));
+            o.height = std::max(0.0, ReadF32(p + 12));
+        }
+
+        ReleasePages(data, LEVEL_CHUNK_BYTES);
+    }
+
+    // 后台线程：每次被唤醒后按块号从小到大处理所有待加载的槽位（离镜头近的先就绪）
+    int LoaderThread(void*)
+    {
+        for (;;)
+        {
+            SDL_SemWait(g_wake);
+            if (g_stopping.load(std::memory_order_acquire))
+                return 0;
+            for (;;)
+            {
+                ChunkSlot* next = nullptr;
+                for (ChunkSlot& slot : g_slots)
+                {
+                    if (slot.state.load(std::memory_order_acquire) == SLOT_LOADING &&
+                        (!next || slot.chunk < next->chunk))
+                        next = &slot;
+                }
+                if (!next)
+                    break;
+                DecodeChunk(next->chunk, next->data);
+                g_loaded.fetch_add(1, std::memory_order_relaxed);
+                next->state.store(SLOT_READY, std::memory_order_release);
+            }
+        }
+    }
+
+    int ChunkOf(double distance)
+    {
+        return static_cast<int>(Clamp(std::floor(distance / LEVEL_CHUNK_HEIGHT), 0.0, g_chunkCount - 1.0));
+    }
+
+    // 卷轴距离 → 屏幕 y（屏幕下边缘是镜头所在的距离）
+    double ScreenY(double distance)
+    {
+        return GAME_HEIGHT - (distance - g_distance);
+    }
+
+    // 请求加载第 chunk 块；槽位里的旧请求还在解码时下个 tick 再试
+    void RequestChunk(int chunk)
+    {
+        ChunkSlot& slot = g_slots[chunk % LEVEL_CHUNK_SLOTS];
+        int state = slot.state.load(std::memory_order_acquire);
+        if ((slot.chunk == chunk && state != SLOT_EMPTY) || state == SLOT_LOADING)
+            return;
+        slot.chunk = chunk;
+        slot.state.store(SLOT_LOADING, std::memory_order_release);
+        SDL_SemPost(g_wake);
+    }
+
+    const LevelChunk* ReadyChunk(int chunk)
+    {
+        const ChunkSlot& slot = g_slots[chunk % LEVEL_CHUNK_SLOTS];
+        if (slot.state.load(std::memory_order_acquire) != SLOT_READY || slot.chunk != chunk)
+            return nullptr;
+        return &slot.data;
+    }
+
+    EnemyType SpawnEnemyType(int kind)
+    {
+        static_assert(LEVEL_SPAWN_SHOOTER - LEVEL_SPAWN_ZIGZAG == ENEMY_TYPE_SHOOTER - ENEMY_TYPE_ZIGZAG,
+                      "Level spawn kinds follow the enemy type order");
+        if (kind < LEVEL_SPAWN_ZIGZAG || kind > LEVEL_SPAWN_SHOOTER)
+            return ENEMY_TYPE_BASIC;
+        return static_cast<EnemyType>(ENEMY_TYPE_ZIGZAG + (kind - LEVEL_SPAWN_ZIGZAG));
+    }
+
+    void Spawn(const LevelSpawn& spawn)
+    {
+        // 出现点越过屏幕顶端的那一刻，物体的下边缘正好在该处
+        double bottom = ScreenY(spawn.distance);
+        if (spawn.kind == LEVEL_SPAWN_BOSS)
+        {
+            const double width = 9 * BOSS_CELL_WIDTH, height = 5 * BOSS_CELL_HEIGHT;
+            CreateBoss(Clamp(spawn.x, 0.0, GAME_WIDTH - width), bottom - height);
+        }
+        else
+            CreateEnemy(Clamp(spawn.x, 0.0, GAME_WIDTH - ENEMY_WIDTH), bottom - ENEMY_HEIGHT, SpawnEnemyType(spawn.kind));
+    }
+
+    void SetBlockedCells(const std::array<bool, kFlowColumns * kFlowRows>& next)
+    {
+        for (int i = 0; i < kFlowColumns * kFlowRows; ++i)
+        {
+            if (next[i] != g_blocked[i])
+                FlowFieldSetBlocked(i % kFlowColumns, i / kFlowColumns, next[i]);
+        }
+        g_blocked = next;
+    }
+
+    // 屏幕内的障碍覆盖的流场格子标记为障碍（只在集合变化时触发流场重建）
+    void UpdateBlockedCells()
+    {
+        std::array<bool, kFlowColumns * kFlowRows> next = {};
+        for (int i = 0; i < g_visibleCount; ++i)
+        {
+            const Rect& r = g_visible[i];
+            int x0 = static_cast<int>(Clamp(r.left / FLOW_CELL_SIZE, 0.0, kFlowColumns - 1.0));
+            int x1 = static_cast<int>(Clamp(r.right / FLOW_CELL_SIZE, 0.0, kFlowColumns - 1.0));
+            int y0 = static_cast<int>(Clamp(r.top / FLOW_CELL_SIZE, 0.0, kFlowRows - 1.0));
+            int y1 = static_cast<int>(Clamp(r.bottom / FLOW_CELL_SIZE, 0.0, kFlowRows - 1.0));
+            for (int y = y0; y <= y1; ++y)
+                for (int x = x0; x <= x1; ++x)
+                    next[y * kFlowColumns + x] = true;
+        }
+        SetBlockedCells(next);
+    }
+
+    // 障碍挡住玩家：沿穿透最浅的方向把玩家推出去
+    void PushPlayersOut()
+    {
+        for (int p = 0; p < GetPlayerCount(); ++p)
+        {
+            Player* player = GetPlayerByIndex(p);
+            for (int i = 0; i < g_visibleCount; ++i)
+            {
+                const Rect& r = g_visible[i];
+                Rect body = CreateRect(player->position, player->width, player->height);
+                if (!IsRectRectCollision(body, r))
+                    continue;
+                double left = body.right - r.left;
+                double right = r.right - body.left;
+                double up = body.bottom - r.top;
+                double down = r.bottom - body.top;
+                double shortest = std::min(std::min(left, right), std::min(up, down));
+                if (shortest == left)
+                    player->position.x -= left;
+                else if (shortest == right)
+                    player->position.x += right;
+                else if (shortest == up)
+                    player->position.y -= up;
+                else
+                    player->position.y += down;
+                player->position.x = Clamp(player->position.x, 0.0, GAME_WIDTH - player->width);
+                player->position.y = Clamp(player->position.y, 0.0, GAME_HEIGHT - player->height);
+            }
+        }
+    }
+}
+
+bool LevelGenerate(const char* path, int chunkCount, unsigned int seed)
+{
+    if (chunkCount <= 0)
+        return false;
+    FILE* file = std::fopen(path, "wb");
+    if (!file)
+    {
+        SDL_Log("LevelGenerate: cannot write %s", path);
+        return false;
+    }
+
+    unsigned int state = seed ? seed : 1u;
+    auto random = [&state](int min, int max) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return min + static_cast<int>(state % static_cast<unsigned int>(max - min + 1));
+    };
+
+    std::vector<unsigned char> block(LEVEL_CHUNK_BYTES);
+    std::memcpy(block.data(), "ACLV", 4);
+    PutU32(block.data() + 4, kVersion);
+    PutU32(block.data() + 8, LEVEL_CHUNK_BYTES);
+    PutU32(block.data() + 12, LEVEL_CHUNK_HEIGHT);
+    PutU32(block.data() + 16, static_cast<uint32_t>(chunkCount));
+    std::fwrite(block.data(), 1, block.size(), file);
+
+    // 开头一屏留空，玩家不会一开始就和障碍重叠；每 40 块出现一个 Boss
+    const int quietChunks = (GAME_HEIGHT + LEVEL_CHUNK_HEIGHT - 1) / LEVEL_CHUNK_HEIGHT;
+    for (int chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        std::fill(block.begin(), block.end(), 0);
+        bool quiet = chunk < quietChunks;
+        int spawnCount = quiet ? 0 : random(2, 6);
+        bool boss = !quiet && chunk % 40 == 39;
+        int obstacleCount = quiet ? 0 : random(0, 2);
+
+        std::vector<int> ys(spawnCount);
+        for (int& y : ys)
+            y = random(0, LEVEL_CHUNK_HEIGHT - 1);
+        std::sort(ys.begin(), ys.end());
+
+        PutU16(block.data(), static_cast<unsigned int>(spawnCount + (boss ? 1 : 0)));
+        PutU16(block.data() + 2, static_cast<unsigned int>(obstacleCount));
+        unsigned char* p = block.data() + 4;
+        for (int i = 0; i < spawnCount; ++i, p += 12)
+        {
+            PutF32(p, random(30, GAME_WIDTH - ENEMY_WIDTH - 30));
+            PutF32(p + 4, ys[i]);
+            // 一半是基础型，其余按 2:1:1:1 分给之字形、俯冲、射手和重装
+            static const LevelSpawnKind kKinds[10] = {
+                LEVEL_SPAWN_ENEMY, LEVEL_SPAWN_ENEMY, LEVEL_SPAWN_ENEMY, LEVEL_SPAWN_ENEMY, LEVEL_SPAWN_ENEMY,
+                LEVEL_SPAWN_ZIGZAG, LEVEL_SPAWN_ZIGZAG, LEVEL_SPAWN_DIVER, LEVEL_SPAWN_SHOOTER, LEVEL_SPAWN_TANK};
+            PutU32(p + 8, kKinds[random(0, 9)]);
+        }
+        if (boss)
+        {
+            PutF32(p, (GAME_WIDTH - 9 * BOSS_CELL_WIDTH) / 2.0);
+            PutF32(p + 4, LEVEL_CHUNK_HEIGHT - 1);
+            PutU32(p + 8, LEVEL_SPAWN_BOSS);
+            p += 12;
+        }
+        for (int i = 0; i < obstacleCount; ++i, p += 16)
+        {
+            int width = random(60, 200);
+            int height = random(40, 160);
+            PutF32(p, random(0, GAME_WIDTH - width));
+            PutF32(p + 4, random(0, LEVEL_CHUNK_HEIGHT - height));
+            PutF32(p + 8, width);
+            PutF32(p + 12, height);
+        }
+        std::fwrite(block.data(), 1, block.size(), file);
+    }
+
+    bool ok = std::ferror(file) == 0;
+    std::fclose(file);
+    return ok;
+}
+
+bool LevelOpen(const char* path)
+{
+    if (g_open)
+        LevelClose();
+
+    if (!MapFile(path))
+    {
+        SDL_Log("LevelOpen: cannot map %s", path);
+        return false;
+    }
+    uint32_t chunkCount = g_mapSize >= 20 ? ReadU32(g_map + 16) : 0;
+    if (g_mapSize < LEVEL_CHUNK_BYTES || std::memcmp(g_map, "ACLV", 4) != 0 || ReadU32(g_map + 4) != kVersion ||
+        ReadU32(g_map + 8) != LEVEL_CHUNK_BYTES || ReadU32(g_map + 12) != LEVEL_CHUNK_HEIGHT || chunkCount == 0 ||
+        g_mapSize < (static_cast<size_t>(chunkCount) + 1) * LEVEL_CHUNK_BYTES)
+    {
+        SDL_Log("LevelOpen: %s is not a level file (or was written with different chunk settings)", path);
+        UnmapFile();
+        return false;
+    }
+    g_chunkCount = static_cast<int>(chunkCount);
+
+    for (ChunkSlot& slot : g_slots)
+    {
+        slot.state.store(SLOT_EMPTY);
+        slot.chunk = -1;
+    }
+    g_stopping.store(false);
+    g_loaded.store(0);
+    g_wake = SDL_CreateSemaphore(0);
+    g_loader = g_wake ? SDL_CreateThread(LoaderThread, "level", nullptr) : nullptr;
+    if (!g_loader)
+    {
+        SDL_Log("LevelOpen: cannot start loader thread - %s", SDL_GetError());
+        if (g_wake)
+            SDL_DestroySemaphore(g_wake);
+        g_wake = nullptr;
+        UnmapFile();
+        return false;
+    }
+
+    g_open = true;
+    g_lateTicks = 0;
+    SetEnemyAutoSpawn(false);
+    SetBossAutoSpawn(false);
+    LevelRestart();
+    SDL_Log("Level: %s, %d chunks (%.0f px)", path, g_chunkCount, g_chunkCount * static_cast<double>(LEVEL_CHUNK_HEIGHT));
+    return true;
+}
+
+void LevelClose()
+{
+    if (!g_open)
+        return;
+
+    g_stopping.store(true, std::memory_order_release);
+    SDL_SemPost(g_wake);
+    SDL_WaitThread(g_loader, nullptr);
+    SDL_DestroySemaphore(g_wake);
+    g_loader = nullptr;
+    g_wake = nullptr;
+    UnmapFile();
+
+    SetBlockedCells({});
+    g_visibleCount = 0;
+    g_open = false;
+    SetEnemyAutoSpawn(true);
+    SetBossAutoSpawn(true);
+    SDL_Log("Level: %d chunks loaded, %d late ticks", g_loaded.load(), g_lateTicks);
+}
+
+bool LevelIsOpen()
+{
+    return g_open;
+}
+
+void LevelRestart()
+{
+    if (!g_open)
+        return;
+    g_distance = 0.0;
+    g_spawnChunk = 0;
+    g_spawnIndex = 0;
+    g_completeLogged = false;
+    g_visibleCount = 0;
+    SetBlockedCells({});
+    // 开头的几块立即开始加载
+    for (int chunk = 0; chunk < std::min(g_chunkCount, kVisibleChunks + LEVEL_LOOKAHEAD_CHUNKS); ++chunk)
+        RequestChunk(chunk);
+}
+
+void LevelUpdate(double deltaTime)
+{
+    if (!g_open)
+        return;
+
+    // ===== 推进镜头，请求屏幕内和前方的块 =====
+    const double length = g_chunkCount * static_cast<double>(LEVEL_CHUNK_HEIGHT);
+    g_distance = std::min(g_distance + g_scrollSpeed * deltaTime, std::max(0.0, length - GAME_HEIGHT));
+    if (g_distance >= length - GAME_HEIGHT && !g_completeLogged)
+    {
+        SDL_Log("Level: reached the end (%d chunks loaded, %d late ticks)", g_loaded.load(), g_lateTicks);
+        g_completeLogged = true;
+    }
+    const double top = g_distance + GAME_HEIGHT;
+    int first = ChunkOf(g_distance);
+    int last = std::min(ChunkOf(top) + LEVEL_LOOKAHEAD_CHUNKS, g_chunkCount - 1);
+    for (int chunk = first; chunk <= last; ++chunk)
+        RequestChunk(chunk);
+
+    // ===== 越过屏幕顶端的出现点 =====
+    // 镜头一个 tick 内越过了整块时，已经落到屏幕下方的出现点直接跳过
+    if (g_spawnChunk < first)
+    {
+        g_spawnChunk = first;
+        g_spawnIndex = 0;
+    }
+    bool late = false;
+    while (g_spawnChunk < g_chunkCount && g_spawnChunk * static_cast<double>(LEVEL_CHUNK_HEIGHT) <= top)
+    {
+        const LevelChunk* chunk = ReadyChunk(g_spawnChunk);
+        if (!chunk)
+        {
+            LogWrite(LOG_LEVEL_LATE, g_spawnChunk, g_distance);
+            late = true;
+            break;
+        }
+        if (g_spawnIndex >= chunk->spawnCount)
+        {
+            g_spawnChunk++;
+            g_spawnIndex = 0;
+            continue;
+        }
+        const LevelSpawn& spawn = chunk->spawns[g_spawnIndex];
+        if (spawn.distance > top)
+            break;
+        Spawn(spawn);
+        g_spawnIndex++;
+    }
+
+    // ===== 屏幕内的障碍 =====
+    g_visibleCount = 0;
+    for (int c = first; c <= ChunkOf(top); ++c)
+    {
+        const LevelChunk* chunk = ReadyChunk(c);
+        if (!chunk)
+        {
+            LogWrite(LOG_LEVEL_LATE, c, g_distance);
+            late = true;
+            continue;
+        }
+        for (int i = 0; i < chunk->obstacleCount; ++i)
+        {
+            const LevelObstacle& o = chunk->obstacles[i];
+            Rect r = {o.x, o.x + o.width, ScreenY(o.distance + o.height), ScreenY(o.distance)};
+            if (r.bottom > 0.0 && r.top < GAME_HEIGHT)
+                g_visible[g_visibleCount++] = r;
+        }
+    }
+    if (late)
+        g_lateTicks++;
+
+    UpdateBlockedCells();
+    PushPlayersOut();
+}
+
+void LevelRender(SDL_Renderer* renderer)
+{
+    if (!renderer || g_visibleCount == 0)
+        return;
+    for (int i = 0; i < g_visibleCount; ++i)
+    {
+        const Rect& r = g_visible[i];
+        g_drawRects[i] = {static_cast<int>(r.left), static_cast<int>(r.top), static_cast<int>(r.right - r.left),
+                          static_cast<int>(r.bottom - r.top)};
+    }
+    SDL_SetRenderDrawColor(renderer, 70, 90, 75, 255);
+    SDL_RenderFillRects(renderer, g_drawRects, g_visibleCount);
+}
+
+void SetLevelScrollSpeed(double speed)
+{
+    g_scrollSpeed = speed > 0.0 ? speed : 0.0;
+}
+
+double GetLevelDistance()
+{
+    return g_distance;
+}
+
+int GetLevelChunkCount()
+{
+    return g_chunkCount;
+}
+
+int GetLevelChunksLoaded()
+{
+    return g_loaded.load(std::memory_order_relaxed);
+}
+
+int GetLevelLateTicks()
+{
+    return g_lateTicks;
+}
+
+void LevelFormatStats(char* buffer, int size)
+{
+    double length = g_chunkCount * static_cast<double>(LEVEL_CHUNK_HEIGHT) - GAME_HEIGHT;
+    std::snprintf(buffer, size, "Level %.0f%%  chunk %d/%d  loaded %d  late %d",
+                  length > 0.0 ? g_distance * 100.0 / length : 100.0, ChunkOf(g_distance) + 1, g_chunkCount,
+                  GetLevelChunksLoaded(), g_lateTicks);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+struct SDL_Renderer;
+
+// ===== 纵向卷轴关卡（流式加载）=====
+// 关卡沿卷轴方向切成固定长度的数据块，每块记录其中的敌机/Boss 出现点和障碍物。
+// 关卡文件只做只读内存映射，后台线程在镜头前方 LEVEL_LOOKAHEAD_CHUNKS 块处解码数据块，
+// 放入 LEVEL_CHUNK_SLOTS 个常驻槽位（按块号取模循环使用，镜头后方的块自然被覆盖），
+// 解码后立即释放该块映射的页面，因此内存占用与关卡长度无关。
+// 游戏线程从不等待加载：需要的块还没准备好时只记一次"迟到"，出现点在块就绪后补上。
+//
+// 文件格式（小端，每块 LEVEL_CHUNK_BYTES 字节，是页大小的整数倍）：
+//   第 0 块是文件头  "ACLV"  u32 版本  u32 块字节数  u32 块高度（像素）  u32 块数
+//   第 1..N 块      u16 出现点数  u16 障碍数
+//                  出现点：f32 x  f32 y  u32 类型（LevelSpawnKind）
+//                  障碍：  f32 x  f32 y  f32 宽  f32 高
+// 块内 y 是到该块起点（下边缘）的卷轴距离，向上为正；障碍的 y 是其下边缘，整个障碍位于块内
+
+// 出现点类型（只在末尾追加，旧关卡文件保持有效；未知类型按基础型敌机生成）
+enum LevelSpawnKind
+{
+    LEVEL_SPAWN_ENEMY = 0,      // 基础型敌机
+    LEVEL_SPAWN_BOSS,
+    LEVEL_SPAWN_ZIGZAG,         // 以下依次对应 ENEMY_TYPE_ZIGZAG 之后的敌机类型
+    LEVEL_SPAWN_DIVER,
+    LEVEL_SPAWN_TANK,
+    LEVEL_SPAWN_SHOOTER
+};
+
+// 生成一个随机关卡文件（固定种子，内容只取决于 seed），失败时返回 false
+bool LevelGenerate(const char* path, int chunkCount, unsigned int seed);
+
+// 映射关卡文件并启动后台加载线程；打开期间关闭敌机和 Boss 的定时生成，改由关卡出现点生成
+bool LevelOpen(const char* path);
+
+// 停止加载线程、解除映射并恢复定时生成
+void LevelClose();
+
+// 是否已打开关卡
+bool LevelIsOpen();
+
+// 镜头回到关卡起点（重置游戏时调用，未打开关卡时不做任何事）
+void LevelRestart();
+
+// 推进镜头：请求前方的数据块，生成越过屏幕顶端的出现点，更新障碍（流场与玩家阻挡）
+// 在 UpdatePlayer 之后、UpdateEnemies 之前调用
+void LevelUpdate(double deltaTime);
+
+// 绘制屏幕内的障碍
+void LevelRender(SDL_Renderer* renderer);
+
+// 设置卷轴速度（像素/秒）
+void SetLevelScrollSpeed(double speed);
+
+// 统计信息
+double GetLevelDistance();      // 镜头（屏幕下边缘）已经走过的距离（像素）
+int GetLevelChunkCount();       // 关卡的块数
+int GetLevelChunksLoaded();     // 后台线程累计解码的块数
+int GetLevelLateTicks();        // 需要的块还没就绪的 tick 数
+
+// 把进度和加载统计格式化为一行文字（供 HUD 显示）
+void LevelFormatStats(char* buffer, int size);
@@ -1,18 +1,95 @@
+#include "audio/audio.h"
 #include "core/core.h"
+#include "core/frame_pacer.h"
+#include "core/governor.h"
+#include "game_object/player.h"
 #include "input/input.h"
+#include "level/level.h"
+#include "net/session.h"
+#include "util/alloc_tracker.h"
 #include "util/config.h"
+#include "util/log.h"
+#include "util/telemetry.h"
 
 #include <SDL.h>
+#include <cstdlib>
+#include <cstring>
 
 // 游戏主程序入口
+// 命令行参数：
+//   --host [port]         以主机身份启动双人联机（本机为玩家 1）
+//   --join [addr] [port]  以客户端身份加入（本机为玩家 2，默认 127.0.0.1）
+//   --low-latency         关闭垂直同步，使用精确限帧并尽量晚地轮询输入
+//   --fps N               低延迟模式下的目标帧率（默认 TARGET_FPS）
+//   --alloc-check [N]     自动操作运行 N 帧，预热后任何一帧发生堆分配即以失败退出
+//                         （需要以 AIRCOMBAT_TRACK_ALLOCATIONS 构建）
+//   --first-frame-check   提交第一帧后立即退出，首帧耗时超过 FIRST_FRAME_TARGET_MS 时以失败退出
+//   --telemetry FILE      把每个 tick 的统计写入 FILE（用 telemetry_dump 转成 CSV）
+//   --level FILE          单机游玩纵向卷轴关卡（用 level_gen 生成）
+//   --log FILE            把生成、命中、超时帧等诊断记录写入二进制日志 FILE（用 log_dump 转成文字）
 int main(int argc, char** argv)
 {
-    (void)argc;  // 消除未使用参数警告
-    (void)argv;
+    // 启动计时从这里开始，第一帧提交后输出首帧耗时
+    FramePacerMarkProcessStart();
+    // 分配统计需要在 SDL 分配任何内存之前接管内存函数
+    AllocTrackerInstall();
+
+    // ===== 解析命令行 =====
+    NetMode netMode = NET_MODE_OFFLINE;
+    const char* netHost = "127.0.0.1";
+    unsigned short netPort = NET_DEFAULT_PORT;
+    bool lowLatency = false;
+    int targetFps = TARGET_FPS;
+    int allocCheckFrames = 0;
+    bool firstFrameCheck = false;
+    const char* telemetryPath = nullptr;
+    const char* levelPath = nullptr;
+    const char* logPath = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--host") == 0)
+        {
+            netMode = NET_MODE_HOST;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                netPort = static_cast<unsigned short>(std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--join") == 0)
+        {
+            netMode = NET_MODE_CLIENT;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                netHost = argv[++i];
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                netPort = static_cast<unsigned short>(std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--low-latency") == 0)
+            lowLatency = true;
+        else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+            targetFps = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--alloc-check") == 0)
+        {
+            allocCheckFrames = ALLOC_CHECK_FRAMES;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                allocCheckFrames = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--first-frame-check") == 0)
+            firstFrameCheck = true;
+        else if (std::strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc)
+            telemetryPath = argv[++i];
+        else if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc)
+            levelPath = argv[++i];
+        else if (std::strcmp(argv[i], "--log") == 0 && i + 1 < argc)
+            logPath = argv[++i];
+    }
+
+    if (allocCheckFrames > 0 && !AllocTrackerIsEnabled())
+    {
+        SDL_Log("--alloc-check requires a build with AIRCOMBAT_TRACK_ALLOCATIONS");
+        return 2;
+    }
 
     // ===== SDL 初始化 =====
-    // 初始化 SDL2 库，启用视频和定时器功能
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0)
+    // 初始化 SDL2 库，启用视频、定时器和音频功能
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_AUDIO) != 0)
         return 1;  // 初始化失败
 
     // 创建游戏窗口
@@ -33,10 +110,11 @@ int main(int argc, char** argv)
     // 创建渲染器（用于绘制图形）
     // SDL_RENDERER_ACCELERATED: 使用硬件加速
     // SDL_RENDERER_PRESENTVSYNC: 启用垂直同步（防止撕裂）
-    SDL_Renderer* renderer = SDL_CreateRenderer(
-        window,
-        -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    // 低延迟模式不开垂直同步：提交画面不再等待下一次刷新，帧节奏由 FramePacerWait 控制
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+    if (!lowLatency)
+        rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, rendererFlags);
 
     if (!renderer)
     {
@@ -45,11 +123,44 @@ int main(int argc, char** argv)
         return 1;
     }
 
+    // ===== 联机初始化 =====
+    // 联机时固定两名玩家，客户端控制玩家 2
+    if (netMode != NET_MODE_OFFLINE)
+        SetPlayerCount(2);
+    if (netMode == NET_MODE_CLIENT)
+        SetLocalPlayerIndex(1);
+    if (netMode == NET_MODE_HOST && !NetHostStart(netPort))
+        netMode = NET_MODE_OFFLINE;
+    if (netMode == NET_MODE_CLIENT && !NetJoinStart(netHost, netPort))
+    {
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        SDL_Quit();
+        return 1;
+    }
+
     // ===== 游戏初始化 =====
+    // 日志最先打开，初始化阶段生成的敌机也会被记录
+    if (logPath)
+        LogOpen(logPath);
+    // 没有音频设备时静音运行
+    AudioInit();
     GameInit();
+    FramePacerInit(lowLatency, targetFps);
+    GovernorInit(targetFps);
+    // 客户端不运行游戏逻辑，没有可记录的数据
+    if (telemetryPath && netMode != NET_MODE_CLIENT)
+        TelemetryOpen(telemetryPath);
+    // 关卡的障碍不在快照中同步，只支持单机
+    if (levelPath && netMode != NET_MODE_OFFLINE)
+        SDL_Log("--level is only supported in single-player games, ignoring %s", levelPath);
+    else if (levelPath)
+        LevelOpen(levelPath);
 
     // ===== 主游戏循环 =====
     bool running = true;
+    int frameIndex = 0;
+    int allocFailures = 0;  // 预热后发生过分配的帧数
     
     // 获取 CPU 性能计数器频率（用于计算 deltaTime）
     const double freq = static_cast<double>(SDL_GetPerformanceFrequency());
@@ -57,6 +168,12 @@ int main(int argc, char** argv)
 
     while (running)
     {
+        // --- 帧率限制（仅低延迟模式）---
+        // 先等待再轮询输入，使输入尽量靠近本帧的更新
+        FramePacerWait();
+        // 帧时间预算只统计工作时间（从这里到提交画面之前）
+        GovernorBeginFrame();
+
         // --- 输入处理 ---
         InputBeginFrame();
 
@@ -67,6 +184,10 @@ int main(int argc, char** argv)
             if (e.type == SDL_QUIT)  // 窗口关闭按钮
                 running = false;
             InputProcessEvent(e);    // 更新输入状态
+
+            // 记录输入事件的时间戳，用于测量输入到显示的延迟
+            if (e.type == SDL_KEYDOWN || e.type == SDL_KEYUP || e.type == SDL_MOUSEBUTTONDOWN)
+                FramePacerNoteInput(e.common.timestamp);
         }
 
         // ESC 键退出游戏
@@ -83,17 +204,68 @@ int main(int argc, char** argv)
         if (deltaTime > 0.1)
             deltaTime = 0.1;
 
+        // 分配检查：自动开火并左右往返移动
+        if (allocCheckFrames > 0)
+            GameSetInputOverride(true, INPUT_FIRE | ((frameIndex / 60) % 2 ? INPUT_RIGHT : INPUT_LEFT));
+
         // --- 游戏逻辑更新和渲染 ---
-        GameUpdate(deltaTime);
+        // 客户端不运行游戏逻辑，只显示主机发来的状态
+        if (netMode == NET_MODE_CLIENT)
+            NetClientUpdate(InputGetFrameBits(), deltaTime);
+        else
+        {
+            NetHostReceiveInputs();
+            GameUpdate(deltaTime);
+            NetHostSendSnapshot();
+        }
         GameRender(renderer);
+        GovernorEndFrame();
         SDL_RenderPresent(renderer);  // 提交渲染到屏幕
+        FramePacerPresented();
+        if (firstFrameCheck)
+            running = false;
+
+        // --- 分配统计 ---
+        AllocTrackerEndFrame();
+        if (allocCheckFrames > 0)
+        {
+            const AllocFrameStats& stats = GetAllocLastFrame();
+            if (frameIndex >= ALLOC_CHECK_WARMUP_FRAMES && stats.totalCount > 0)
+            {
+                allocFailures++;
+                for (int scope = 0; scope < ALLOC_SCOPE_COUNT; ++scope)
+                {
+                    if (stats.count[scope] > 0)
+                        SDL_Log("alloc-check: frame %d scope %s allocated %u times (%llu bytes)", frameIndex,
+                                GetAllocScopeName(static_cast<AllocScope>(scope)), stats.count[scope],
+                                stats.bytes[scope]);
+                }
+            }
+            if (frameIndex + 1 >= allocCheckFrames)
+                running = false;
+        }
+        frameIndex++;
     }
 
     // ===== 清理资源 =====
+    TelemetryClose();
+    LevelClose();
+    LogClose();
     GameShutdown();
+    NetShutdown();
+    AudioShutdown();
 
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();
+
+    if (allocCheckFrames > 0)
+    {
+        SDL_Log("alloc-check: %d of %d steady-state frames allocated", allocFailures,
+                frameIndex > ALLOC_CHECK_WARMUP_FRAMES ? frameIndex - ALLOC_CHECK_WARMUP_FRAMES : 0);
+        return allocFailures > 0 ? 1 : 0;
+    }
+    if (firstFrameCheck)
+        return FramePacerGetFirstFrameMs() <= FIRST_FRAME_TARGET_MS ? 0 : 1;
     return 0;
 }
@@ -0,0 +1,512 @@
+#include "session.h"
+
+#include "snapshot.h"
+#include "socket.h"
+
+#include "../game_object/particle.h"
+#include "../game_object/player.h"
+#include "../render/background.h"
+#include "../util/config.h"
+
+#include <SDL.h>
+#include <cstdio>
+
+namespace
+{
+    // 双方保存的快照历史长度（差分基准必须仍在历史中）
+    const int kSnapshotHistory = 32;
+    // 表示"没有基准，发送完整快照"
+    const unsigned int kNoBaseline = 0xFFFFFFFFu;
+
+    // 包类型
+    const unsigned char kPacketInput = 1;     // 客户端 → 主机
+    const unsigned char kPacketSnapshot = 2;  // 主机 → 客户端
+
+    // 输入包：类型(1) + 客户端时间(4) + 确认 tick(4) + 输入位(1) + RTT(2) + E2E(2)
+    const int kInputPacketSize = 14;
+    // 快照包头：类型(1) + 基准 tick(4) + 回显的客户端时间(4)
+    // 回显时间是本快照之前已生效的最新输入的发送时间：主机先收输入、再 GameUpdate、最后采集快照
+    const int kSnapshotHeaderSize = 9;
+
+    // 每秒字节数统计（1 秒滑动窗口）
+    struct RateCounter
+    {
+        Uint32 windowStartMs;
+        int windowBytes;
+        int bytesPerSecond;
+    };
+
+    NetMode g_mode = NET_MODE_OFFLINE;
+    NetSocket g_socket = -1;
+
+    // 对端地址（主机：首个发来输入的客户端；客户端：主机）
+    NetAddress g_peer = {};
+    bool g_hasPeer = false;
+    Uint32 g_lastHeardMs = 0;
+
+    // ----- 主机状态 -----
+    unsigned int g_tick = 0;                  // 当前服务器 tick
+    Snapshot g_history[kSnapshotHistory];     // 按 tick 取模存放的历史快照
+    unsigned int g_ackTick = kNoBaseline;     // 客户端最后确认收到的 tick
+    unsigned int g_echoClientTime = 0;        // 最近一次输入包的客户端时间（原样回显）
+    unsigned int g_remoteInput = 0;           // 远端玩家的输入位（最近一个输入包）
+
+    // 本帧收到的远端输入：每个输入包的位掩码覆盖客户端上一包到这一包之间的时间
+    struct RemoteInput
+    {
+        unsigned int clientTimeMs;
+        unsigned int bits;
+    };
+    RemoteInput g_remoteInputs[INPUT_MAX_SEGMENTS];
+    int g_remoteInputCount = 0;
+    unsigned int g_remoteWindowStartMs = 0;   // 上一帧最后一个输入包的客户端时间（本帧时间窗口的起点）
+    bool g_hasRemoteWindow = false;
+
+    // ----- 客户端状态 -----
+    unsigned int g_latestTick = kNoBaseline;  // 已收到的最新 tick
+    unsigned int g_shownTick = kNoBaseline;   // 上一帧画面完整包含的快照 tick
+    double g_clockOffset = 0.0;               // 服务器时间 - 本地时间（毫秒）
+    bool g_hasClockOffset = false;
+    Snapshot g_decodeScratch;                 // 解码临时缓冲
+    Snapshot g_interpolated;                  // 插值结果
+    unsigned int g_presentedTick = kNoBaseline;  // 画面上实体集合所来自的快照 tick
+    Snapshot g_presented;                     // 该快照的副本（历史环中的会被覆盖），用于找出消失的实体
+
+    // ----- 统计 -----
+    RateCounter g_sendRate = {};
+    RateCounter g_receiveRate = {};
+    double g_rttMs = 0.0;                     // 平滑后的往返延迟
+    double g_e2eMs = 0.0;                     // 平滑后的端到端延迟（输入发出 → 画面显示）
+
+    unsigned char g_packet[NET_MAX_PACKET];
+
+    void CountBytes(RateCounter& counter, int bytes, Uint32 nowMs)
+    {
+        counter.windowBytes += bytes;
+        Uint32 elapsed = nowMs - counter.windowStartMs;
+        if (elapsed >= 1000)
+        {
+            counter.bytesPerSecond = static_cast<int>(counter.windowBytes * 1000.0 / elapsed);
+            counter.windowBytes = 0;
+            counter.windowStartMs = nowMs;
+        }
+    }
+
+    void WriteU32(unsigned char* p, unsigned int v)
+    {
+        p[0] = static_cast<unsigned char>(v);
+        p[1] = static_cast<unsigned char>(v >> 8);
+        p[2] = static_cast<unsigned char>(v >> 16);
+        p[3] = static_cast<unsigned char>(v >> 24);
+    }
+
+    // 写入 16 位无符号数（超出范围时饱和）
+    void WriteU16Saturated(unsigned char* p, double v)
+    {
+        unsigned int u = v <= 0.0 ? 0u : (v >= 65535.0 ? 0xFFFFu : static_cast<unsigned int>(v + 0.5));
+        p[0] = static_cast<unsigned char>(u);
+        p[1] = static_cast<unsigned char>(u >> 8);
+    }
+
+    unsigned int ReadU32(const unsigned char* p)
+    {
+        return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<unsigned int>(p[3]) << 24);
+    }
+
+    int Send(const void* data, int size)
+    {
+        int sent = NetSocketSend(g_socket, g_peer, data, size);
+        if (sent > 0)
+            CountBytes(g_sendRate, sent, SDL_GetTicks());
+        return sent;
+    }
+
+    // 在历史环中查找指定 tick 的快照
+    Snapshot* FindSnapshot(unsigned int tick)
+    {
+        if (tick == kNoBaseline)
+            return nullptr;
+        Snapshot& s = g_history[tick % kSnapshotHistory];
+        return s.tick == tick ? &s : nullptr;
+    }
+
+    void ResetSession()
+    {
+        g_hasPeer = false;
+        g_tick = 0;
+        g_ackTick = kNoBaseline;
+        g_latestTick = kNoBaseline;
+        g_shownTick = kNoBaseline;
+        g_presentedTick = kNoBaseline;
+        g_echoClientTime = 0;
+        g_remoteInput = 0;
+        g_remoteInputCount = 0;
+        g_hasRemoteWindow = false;
+        g_hasClockOffset = false;
+        g_rttMs = 0.0;
+        g_e2eMs = 0.0;
+        g_sendRate = {SDL_GetTicks(), 0, 0};
+        g_receiveRate = {SDL_GetTicks(), 0, 0};
+        for (Snapshot& s : g_history)
+            s.tick = kNoBaseline;
+    }
+
+    // 主机：记录一个输入包，返回是否接受（乱序到达的旧包丢弃；本帧的包数超过容量时并入最后一个，位掩码按位或，点按不丢失）
+    bool QueueRemoteInput(unsigned int clientTimeMs, unsigned int bits)
+    {
+        unsigned int lastMs = g_remoteInputCount > 0 ? g_remoteInputs[g_remoteInputCount - 1].clientTimeMs
+                                                      : g_remoteWindowStartMs;
+        if ((g_remoteInputCount > 0 || g_hasRemoteWindow) && static_cast<int>(clientTimeMs - lastMs) < 0)
+            return false;
+        if (g_remoteInputCount == INPUT_MAX_SEGMENTS)
+        {
+            RemoteInput& last = g_remoteInputs[g_remoteInputCount - 1];
+            last.clientTimeMs = clientTimeMs;
+            last.bits |= bits;
+        }
+        else
+            g_remoteInputs[g_remoteInputCount++] = {clientTimeMs, bits};
+        return true;
+    }
+
+    // 主机：把本帧收到的输入包转换为远端玩家的输入时间线，和本机玩家一样在帧内的真实时刻生效
+    // 时间窗口是上一帧最后一个包到本帧最后一个包（客户端时钟），第 i 段从第 i-1 个包的时间开始
+    void BuildRemoteTimeline(Player& remote)
+    {
+        if (g_remoteInputCount == 0)
+        {
+            // 本帧没有收到输入：沿用最近一次的输入位
+            remote.input = g_remoteInput;
+            remote.inputSegmentCount = 0;
+            return;
+        }
+
+        unsigned int startMs = g_hasRemoteWindow ? g_remoteWindowStartMs : g_remoteInputs[0].clientTimeMs;
+        unsigned int endMs = g_remoteInputs[g_remoteInputCount - 1].clientTimeMs;
+        double span = static_cast<double>(endMs - startMs);
+
+        int count = 0;
+        for (int i = 0; i < g_remoteInputCount; ++i)
+        {
+            // 客户端时间相同（同一毫秒内的多帧）时按包的顺序均分
+            double start;
+            if (i == 0)
+                start = 0.0;
+            else if (span > 0.0)
+                start = (g_remoteInputs[i - 1].clientTimeMs - startMs) / span;
+            else
+                start = static_cast<double>(i) / g_remoteInputCount;
+
+            unsigned int bits = g_remoteInputs[i].bits;
+            if (count > 0 && bits == remote.inputTimeline[count - 1].bits)
+                continue;
+            if (count > 0 && start <= remote.inputTimeline[count - 1].start)
+                remote.inputTimeline[count - 1].bits = bits;
+            else
+                remote.inputTimeline[count++] = {start, bits};
+        }
+        remote.inputSegmentCount = count;
+        remote.input = g_remoteInput;
+    }
+
+    // 客户端：处理一个快照包
+    void HandleSnapshotPacket(const unsigned char* data, int size, Uint32 nowMs)
+    {
+        if (size < kSnapshotHeaderSize)
+            return;
+        unsigned int baseTick = ReadU32(data + 1);
+        unsigned int echoTime = ReadU32(data + 5);
+
+        const Snapshot* base = nullptr;
+        if (baseTick != kNoBaseline)
+        {
+            base = FindSnapshot(baseTick);
+            if (!base)
+                return;  // 基准已被覆盖，等待下一个包
+        }
+
+        if (!SnapshotDecode(data + kSnapshotHeaderSize, size - kSnapshotHeaderSize, base, g_decodeScratch))
+            return;
+
+        // 丢弃乱序到达的旧快照
+        if (g_latestTick != kNoBaseline && static_cast<int>(g_decodeScratch.tick - g_latestTick) <= 0)
+            return;
+
+        g_decodeScratch.inputTimeMs = echoTime;
+        g_history[g_decodeScratch.tick % kSnapshotHistory] = g_decodeScratch;
+        g_latestTick = g_decodeScratch.tick;
+
+        // 往返延迟：当前时间 - 回显的发送时间
+        double rtt = static_cast<double>(nowMs - echoTime);
+        g_rttMs = (g_rttMs <= 0.0) ? rtt : g_rttMs + (rtt - g_rttMs) * 0.1;
+
+        // 估计服务器与本地的时钟差（平滑以吸收抖动）
+        double offset = static_cast<double>(g_decodeScratch.serverTimeMs) - nowMs;
+        if (!g_hasClockOffset)
+        {
+            g_clockOffset = offset;
+            g_hasClockOffset = true;
+        }
+        else
+            g_clockOffset += (offset - g_clockOffset) * 0.05;
+    }
+
+    // 客户端：某个快照第一次完整出现在画面上时，测量其中已生效输入的端到端延迟
+    void MeasureEndToEnd(const Snapshot& shown, Uint32 nowMs)
+    {
+        if (shown.tick == g_shownTick || shown.inputTimeMs == 0)
+            return;
+        g_shownTick = shown.tick;
+        double e2e = static_cast<double>(nowMs - shown.inputTimeMs);
+        g_e2eMs = (g_e2eMs <= 0.0) ? e2e : g_e2eMs + (e2e - g_e2eMs) * 0.1;
+    }
+
+    // 客户端：画面上的实体集合换成另一个快照时，为其间消失的实体播放命中/爆炸效果
+    // 插值结果只包含后一个快照中的实体，所以实体集合来自 after（没有 after 时来自唯一的快照）
+    void PresentRemovals(const Snapshot& entities)
+    {
+        if (entities.tick == g_presentedTick)
+            return;
+        if (g_presentedTick != kNoBaseline && static_cast<int>(entities.tick - g_presentedTick) > 0)
+            SnapshotSpawnRemovalEffects(g_presented, entities);
+        g_presentedTick = entities.tick;
+        g_presented = entities;
+    }
+
+    // 客户端：在历史快照中找到渲染时刻两侧的快照并插值
+    void ApplyInterpolatedWorld(Uint32 nowMs)
+    {
+        if (g_latestTick == kNoBaseline)
+            return;
+
+        double renderTime = nowMs + g_clockOffset - NET_INTERP_DELAY_MS;
+        const Snapshot* before = nullptr;  // 时间 <= renderTime 的最新快照
+        const Snapshot* after = nullptr;   // 时间 > renderTime 的最早快照
+        for (const Snapshot& s : g_history)
+        {
+            if (s.tick == kNoBaseline)
+                continue;
+            if (s.serverTimeMs <= renderTime)
+            {
+                if (!before || s.serverTimeMs > before->serverTimeMs)
+                    before = &s;
+            }
+            else if (!after || s.serverTimeMs < after->serverTimeMs)
+                after = &s;
+        }
+
+        if (before && after)
+        {
+            double t = (renderTime - before->serverTimeMs) / (after->serverTimeMs - before->serverTimeMs);
+            SnapshotInterpolate(*before, *after, t, g_interpolated);
+            PresentRemovals(*after);
+            SnapshotApply(g_interpolated);
+            MeasureEndToEnd(*before, nowMs);
+        }
+        else if (before || after)
+        {
+            const Snapshot& shown = before ? *before : *after;
+            PresentRemovals(shown);
+            SnapshotApply(shown);
+            MeasureEndToEnd(shown, nowMs);
+        }
+    }
+}
+
+bool NetHostStart(unsigned short port)
+{
+    if (!NetSocketStartup())
+        return false;
+    g_socket = NetSocketOpen(port);
+    if (g_socket < 0)
+    {
+        SDL_Log("NetHostStart: failed to bind UDP port %u", port);
+        NetSocketCleanup();
+        return false;
+    }
+    ResetSession();
+    g_mode = NET_MODE_HOST;
+    SDL_Log("NetHostStart: listening on UDP port %u", port);
+    return true;
+}
+
+bool NetJoinStart(const char* host, unsigned short port)
+{
+    if (!NetSocketStartup())
+        return false;
+    g_socket = NetSocketOpen(0);
+    if (g_socket < 0 || !NetResolveAddress(host, port, g_peer))
+    {
+        SDL_Log("NetJoinStart: cannot reach %s:%u", host, port);
+        NetSocketClose(g_socket);
+        g_socket = -1;
+        NetSocketCleanup();
+        return false;
+    }
+    ResetSession();
+    g_hasPeer = true;
+    g_lastHeardMs = SDL_GetTicks();
+    g_mode = NET_MODE_CLIENT;
+    return true;
+}
+
+void NetShutdown()
+{
+    if (g_mode == NET_MODE_OFFLINE)
+        return;
+    NetSocketClose(g_socket);
+    g_socket = -1;
+    NetSocketCleanup();
+    g_mode = NET_MODE_OFFLINE;
+}
+
+NetMode NetGetMode()
+{
+    return g_mode;
+}
+
+void NetHostReceiveInputs()
+{
+    if (g_mode != NET_MODE_HOST)
+        return;
+
+    Uint32 now = SDL_GetTicks();
+    NetAddress from;
+    int size;
+    while ((size = NetSocketReceive(g_socket, from, g_packet, sizeof(g_packet))) > 0)
+    {
+        if (size < kInputPacketSize || g_packet[0] != kPacketInput)
+            continue;
+        // 只接受一个客户端：首个发来输入的地址
+        if (!g_hasPeer)
+        {
+            g_peer = from;
+            g_hasPeer = true;
+            g_ackTick = kNoBaseline;
+            SDL_Log("NetHost: client connected from port %u", from.port);
+        }
+        else if (!NetAddressEqual(from, g_peer))
+            continue;
+
+        CountBytes(g_receiveRate, size, now);
+        g_lastHeardMs = now;
+        g_echoClientTime = ReadU32(g_packet + 1);
+        unsigned int ack = ReadU32(g_packet + 5);
+        if (ack != kNoBaseline && (g_ackTick == kNoBaseline || static_cast<int>(ack - g_ackTick) > 0))
+            g_ackTick = ack;
+        if (QueueRemoteInput(g_echoClientTime, g_packet[9]))
+            g_remoteInput = g_packet[9];
+        g_rttMs = g_packet[10] | (g_packet[11] << 8);  // 客户端测得的 RTT
+        g_e2eMs = g_packet[12] | (g_packet[13] << 8);  // 客户端测得的端到端延迟
+    }
+
+    // 超时视为断开，远端玩家停止操作
+    if (g_hasPeer && now - g_lastHeardMs > NET_TIMEOUT_MS)
+    {
+        SDL_Log("NetHost: client timed out");
+        g_hasPeer = false;
+        g_remoteInput = 0;
+        g_remoteInputCount = 0;
+        g_hasRemoteWindow = false;
+    }
+
+    Player* remote = GetPlayerByIndex(1);
+    if (remote)
+        BuildRemoteTimeline(*remote);
+    if (g_remoteInputCount > 0)
+    {
+        g_remoteWindowStartMs = g_remoteInputs[g_remoteInputCount - 1].clientTimeMs;
+        g_hasRemoteWindow = true;
+        g_remoteInputCount = 0;
+    }
+}
+
+void NetHostSendSnapshot()
+{
+    if (g_mode != NET_MODE_HOST)
+        return;
+
+    Uint32 now = SDL_GetTicks();
+    g_tick++;
+    Snapshot& current = g_history[g_tick % kSnapshotHistory];
+    SnapshotCapture(current, g_tick, now);
+    current.inputTimeMs = g_echoClientTime;
+    CountBytes(g_sendRate, 0, now);
+
+    if (!g_hasPeer)
+        return;
+
+    // 以客户端最后确认的快照为基准（仍在历史中时）
+    const Snapshot* base = FindSnapshot(g_ackTick);
+    if (base && g_tick - g_ackTick >= static_cast<unsigned int>(kSnapshotHistory))
+        base = nullptr;
+
+    g_packet[0] = kPacketSnapshot;
+    WriteU32(g_packet + 5, current.inputTimeMs);
+    int body = SnapshotEncode(current, base, g_packet + kSnapshotHeaderSize, NET_MAX_PACKET - kSnapshotHeaderSize);
+    WriteU32(g_packet + 1, base ? g_ackTick : kNoBaseline);
+    if (body < 0)
+        return;  // 实体数量受 NET_MAX_* 限制，正常不会超出
+    Send(g_packet, kSnapshotHeaderSize + body);
+}
+
+void NetClientUpdate(unsigned int inputBits, double deltaTime)
+{
+    if (g_mode != NET_MODE_CLIENT)
+        return;
+
+    Uint32 now = SDL_GetTicks();
+    NetAddress from;
+    int size;
+    while ((size = NetSocketReceive(g_socket, from, g_packet, sizeof(g_packet))) > 0)
+    {
+        if (!NetAddressEqual(from, g_peer) || g_packet[0] != kPacketSnapshot)
+            continue;
+        CountBytes(g_receiveRate, size, now);
+        g_lastHeardMs = now;
+        HandleSnapshotPacket(g_packet, size, now);
+    }
+    CountBytes(g_receiveRate, 0, now);
+
+    // 每帧发送输入并确认最新快照
+    unsigned char input[kInputPacketSize];
+    input[0] = kPacketInput;
+    WriteU32(input + 1, now);
+    WriteU32(input + 5, g_latestTick);
+    input[9] = static_cast<unsigned char>(inputBits);
+    WriteU16Saturated(input + 10, g_rttMs);
+    WriteU16Saturated(input + 12, g_e2eMs);
+    Send(input, kInputPacketSize);
+
+    ApplyInterpolatedWorld(now);
+
+    // 背景和粒子只是表现，不在快照中：客户端自己推进
+    BackgroundUpdate(deltaTime);
+    UpdateParticles(deltaTime);
+}
+
+void NetFormatStats(char* buffer, int size)
+{
+    if (g_mode == NET_MODE_HOST)
+    {
+        if (!g_hasPeer)
+        {
+            std::snprintf(buffer, size, "Host: waiting for player 2");
+            return;
+        }
+        std::snprintf(buffer, size, "Host  to client %.1f KB/s  from client %.1f KB/s  RTT %.0f ms  E2E %.0f ms",
+                      g_sendRate.bytesPerSecond / 1024.0, g_receiveRate.bytesPerSecond / 1024.0, g_rttMs, g_e2eMs);
+    }
+    else if (g_mode == NET_MODE_CLIENT)
+    {
+        if (g_latestTick == kNoBaseline || SDL_GetTicks() - g_lastHeardMs > NET_TIMEOUT_MS)
+        {
+            std::snprintf(buffer, size, "Client: waiting for host");
+            return;
+        }
+        std::snprintf(buffer, size, "Client  down %.1f KB/s  up %.1f KB/s  RTT %.0f ms  E2E %.0f ms",
+                      g_receiveRate.bytesPerSecond / 1024.0, g_sendRate.bytesPerSecond / 1024.0, g_rttMs, g_e2eMs);
+    }
+    else if (size > 0)
+        buffer[0] = '\0';
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// ===== 双人联机会话（UDP 本机回环） =====
+// 主机运行权威的 GameUpdate，并把差分压缩的快照发送给客户端；
+// 客户端只发送输入位掩码，并在两个快照之间插值显示
+
+// 联机模式
+enum NetMode
+{
+    NET_MODE_OFFLINE,  // 单机
+    NET_MODE_HOST,     // 主机（服务器 + 本机玩家 1）
+    NET_MODE_CLIENT    // 客户端（玩家 2）
+};
+
+// 以主机身份在指定端口监听
+bool NetHostStart(unsigned short port);
+
+// 以客户端身份连接到主机
+bool NetJoinStart(const char* host, unsigned short port);
+
+// 关闭联机会话
+void NetShutdown();
+
+// 获取当前联机模式
+NetMode NetGetMode();
+
+// 主机：接收客户端输入并写入远端玩家（在 GameUpdate 之前调用）
+void NetHostReceiveInputs();
+
+// 主机：采集本 tick 的世界状态并发送快照（在 GameUpdate 之后调用）
+void NetHostSendSnapshot();
+
+// 客户端：发送本帧输入，接收快照，把插值后的状态写入游戏世界，
+// 并推进只在本地运行的表现（背景滚动、粒子、实体消失时的命中/爆炸效果）
+void NetClientUpdate(unsigned int inputBits, double deltaTime);
+
+// 把带宽与延迟统计格式化为一行文字（供 HUD 显示）
+void NetFormatStats(char* buffer, int size);
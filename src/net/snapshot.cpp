@@ -0,0 +1,625 @@
+#include "snapshot.h"
+
+#include "../audio/audio.h"
+#include "../game_object/boss.h"
+#include "../game_object/bullet.h"
+#include "../game_object/enemy.h"
+#include "../game_object/particle.h"
+#include "../game_object/player.h"
+#include "../util/util.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // 敌机类型的编码位数
+    const int kEnemyTypeBits = 3;
+    static_assert(ENEMY_TYPE_COUNT <= (1 << kEnemyTypeBits), "Enemy type must fit in kEnemyTypeBits");
+
+    // 按位写入器（低位在前），写满后 overflow 置位
+    struct BitWriter
+    {
+        unsigned char* data;
+        int capacity;   // 字节容量
+        int bitPos;     // 已写入的位数
+        bool overflow;
+    };
+
+    // 按位读取器，越界时 overflow 置位
+    struct BitReader
+    {
+        const unsigned char* data;
+        int size;       // 字节数
+        int bitPos;     // 已读取的位数
+        bool overflow;
+    };
+
+    void WriteBits(BitWriter& w, unsigned int value, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            int byte = w.bitPos >> 3;
+            if (byte >= w.capacity)
+            {
+                w.overflow = true;
+                return;
+            }
+            if ((w.bitPos & 7) == 0)
+                w.data[byte] = 0;
+            if (value & (1u << i))
+                w.data[byte] |= static_cast<unsigned char>(1u << (w.bitPos & 7));
+            w.bitPos++;
+        }
+    }
+
+    unsigned int ReadBits(BitReader& r, int count)
+    {
+        unsigned int value = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            int byte = r.bitPos >> 3;
+            if (byte >= r.size)
+            {
+                r.overflow = true;
+                return 0;
+            }
+            if (r.data[byte] & (1u << (r.bitPos & 7)))
+                value |= 1u << i;
+            r.bitPos++;
+        }
+        return value;
+    }
+
+    // 无符号整数：2 位长度类别 + 4/8/16/32 位数值（编号差通常很小）
+    void WriteUInt(BitWriter& w, unsigned int value)
+    {
+        if (value < (1u << 4))
+        {
+            WriteBits(w, 0, 2);
+            WriteBits(w, value, 4);
+        }
+        else if (value < (1u << 8))
+        {
+            WriteBits(w, 1, 2);
+            WriteBits(w, value, 8);
+        }
+        else if (value < (1u << 16))
+        {
+            WriteBits(w, 2, 2);
+            WriteBits(w, value, 16);
+        }
+        else
+        {
+            WriteBits(w, 3, 2);
+            WriteBits(w, value, 32);
+        }
+    }
+
+    unsigned int ReadUInt(BitReader& r)
+    {
+        static const int kBits[4] = {4, 8, 16, 32};
+        return ReadBits(r, kBits[ReadBits(r, 2)]);
+    }
+
+    // 有符号差值：zigzag 后用 2 位类别表示 0 / 6 位 / 10 位 / 17 位
+    void WriteDelta(BitWriter& w, int delta)
+    {
+        unsigned int z = (static_cast<unsigned int>(delta) << 1) ^ static_cast<unsigned int>(delta >> 31);
+        if (z == 0)
+            WriteBits(w, 0, 2);
+        else if (z < (1u << 6))
+        {
+            WriteBits(w, 1, 2);
+            WriteBits(w, z, 6);
+        }
+        else if (z < (1u << 10))
+        {
+            WriteBits(w, 2, 2);
+            WriteBits(w, z, 10);
+        }
+        else
+        {
+            WriteBits(w, 3, 2);
+            WriteBits(w, z, 17);
+        }
+    }
+
+    int ReadDelta(BitReader& r)
+    {
+        static const int kBits[4] = {0, 6, 10, 17};
+        unsigned int z = ReadBits(r, kBits[ReadBits(r, 2)]);
+        return static_cast<int>(z >> 1) ^ -static_cast<int>(z & 1);
+    }
+
+    // 编码一个按编号升序排列的实体列表
+    // 基准中存在同编号实体时只写坐标差值，否则写完整坐标
+    void WriteEntities(BitWriter& w, const NetEntity* list, int count, const NetEntity* base, int baseCount)
+    {
+        WriteUInt(w, static_cast<unsigned int>(count));
+        unsigned int prevId = 0;
+        int bi = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            const NetEntity& e = list[i];
+            WriteUInt(w, e.id - prevId);
+            prevId = e.id;
+
+            // 基准列表同样有序，用归并的方式查找同编号实体
+            while (bi < baseCount && base[bi].id < e.id)
+                bi++;
+            if (bi < baseCount && base[bi].id == e.id)
+            {
+                WriteBits(w, 1, 1);
+                WriteDelta(w, e.x - base[bi].x);
+                WriteDelta(w, e.y - base[bi].y);
+            }
+            else
+            {
+                WriteBits(w, 0, 1);
+                WriteBits(w, static_cast<unsigned short>(e.x), 16);
+                WriteBits(w, static_cast<unsigned short>(e.y), 16);
+            }
+        }
+    }
+
+    bool ReadEntities(BitReader& r, NetEntity* list, int& count, int capacity, const NetEntity* base, int baseCount)
+    {
+        count = static_cast<int>(ReadUInt(r));
+        if (count > capacity)
+            return false;
+
+        unsigned int prevId = 0;
+        int bi = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            NetEntity& e = list[i];
+            e.id = prevId + ReadUInt(r);
+            prevId = e.id;
+
+            if (ReadBits(r, 1))
+            {
+                while (bi < baseCount && base[bi].id < e.id)
+                    bi++;
+                if (bi >= baseCount || base[bi].id != e.id)
+                    return false;  // 基准不一致
+                e.x = static_cast<short>(base[bi].x + ReadDelta(r));
+                e.y = static_cast<short>(base[bi].y + ReadDelta(r));
+            }
+            else
+            {
+                e.x = static_cast<short>(ReadBits(r, 16));
+                e.y = static_cast<short>(ReadBits(r, 16));
+            }
+        }
+        return !r.overflow;
+    }
+
+    // 实体的附加标记（敌机类型、子弹是否属于敌机）：标记在实体存在期间不变，只为基准中没有的实体写入
+    // （两个列表都按编号有序，与 WriteEntities 一样用归并查找）
+    void WriteNewTags(BitWriter& w, const NetEntity* list, const unsigned char* tags, int count,
+                      const NetEntity* base, int baseCount, int bits)
+    {
+        int bi = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            while (bi < baseCount && base[bi].id < list[i].id)
+                bi++;
+            if (bi >= baseCount || base[bi].id != list[i].id)
+                WriteBits(w, tags[i], bits);
+        }
+    }
+
+    // 读取附加标记（基准中已有的实体沿用基准的标记），标记不小于 limit 时返回 false
+    bool ReadNewTags(BitReader& r, const NetEntity* list, unsigned char* tags, int count,
+                     const NetEntity* base, const unsigned char* baseTags, int baseCount, int bits, int limit)
+    {
+        int bi = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            while (bi < baseCount && base[bi].id < list[i].id)
+                bi++;
+            if (bi < baseCount && base[bi].id == list[i].id)
+                tags[i] = baseTags[bi];
+            else
+                tags[i] = static_cast<unsigned char>(ReadBits(r, bits));
+            if (tags[i] >= limit)
+                return false;
+        }
+        return !r.overflow;
+    }
+
+    // 基准快照中同编号 Boss 的部件掩码（没有时返回 nullptr）
+    const unsigned long long* FindBossMask(const Snapshot* base, unsigned int id)
+    {
+        if (!base)
+            return nullptr;
+        for (int i = 0; i < base->bossCount; ++i)
+        {
+            if (base->bosses[i].id == id)
+                return &base->bossParts[i];
+        }
+        return nullptr;
+    }
+
+    // 实体当前的位置（子弹按弹道即时计算）
+    Vector2 EntityPosition(const Bullet& bullet)
+    {
+        return GetBulletPosition(bullet);
+    }
+
+    Vector2 EntityPosition(const Boss& boss)
+    {
+        return boss.position;
+    }
+
+    // 采集实体列表并按编号排序
+    template <typename T>
+    int CaptureEntities(const std::vector<T>& source, NetEntity* list, int capacity)
+    {
+        int count = 0;
+        for (const T& item : source)
+        {
+            if (count >= capacity)
+                break;
+            Vector2 position = EntityPosition(item);
+            list[count].id = item.id;
+            list[count].x = NetQuantize(position.x);
+            list[count].y = NetQuantize(position.y);
+            count++;
+        }
+        std::sort(list, list + count, [](const NetEntity& a, const NetEntity& b) { return a.id < b.id; });
+        return count;
+    }
+
+    // 采集子弹并标记敌机子弹（敌机子弹很少，逐颗在按编号排好序的列表中二分查找）
+    int CaptureBullets(Snapshot& out)
+    {
+        int count = CaptureEntities(GetBullets(), out.bullets, NET_MAX_BULLETS);
+        std::fill(out.bulletEnemy, out.bulletEnemy + count, 0);
+        for (const Bullet& bullet : GetBullets())
+        {
+            if (bullet.owner >= 0)
+                continue;
+            const NetEntity* it = std::lower_bound(out.bullets, out.bullets + count, bullet.id,
+                                                   [](const NetEntity& e, unsigned int id) { return e.id < id; });
+            if (it != out.bullets + count && it->id == bullet.id)
+                out.bulletEnemy[it - out.bullets] = 1;
+        }
+        return count;
+    }
+
+    // 采集敌机：各类型数组分别按编号有序，归并成一个按编号升序的列表，同时记下类型
+    int CaptureEnemies(Snapshot& out)
+    {
+        size_t cursor[ENEMY_TYPE_COUNT] = {};
+        int count = 0;
+        while (count < NET_MAX_ENEMIES)
+        {
+            int next = -1;
+            unsigned int nextId = 0;
+            for (int type = 0; type < ENEMY_TYPE_COUNT; ++type)
+            {
+                const std::vector<Enemy>& batch = GetEnemyBatch(static_cast<EnemyType>(type));
+                if (cursor[type] < batch.size() && (next < 0 || batch[cursor[type]].id < nextId))
+                {
+                    next = type;
+                    nextId = batch[cursor[type]].id;
+                }
+            }
+            if (next < 0)
+                break;
+
+            const Enemy& e = GetEnemyBatch(static_cast<EnemyType>(next))[cursor[next]++];
+            out.enemies[count].id = e.id;
+            out.enemies[count].x = NetQuantize(e.position.x);
+            out.enemies[count].y = NetQuantize(e.position.y);
+            out.enemyTypes[count] = static_cast<unsigned char>(next);
+            count++;
+        }
+        return count;
+    }
+
+    // 位置是否在屏幕内（用于区分被击毁和离开屏幕）
+    bool IsOnScreen(Vector2 p)
+    {
+        return p.x >= 0.0 && p.x <= GAME_WIDTH && p.y >= 0.0 && p.y <= GAME_HEIGHT;
+    }
+
+    // 插值实体列表：按编号匹配 a 与 b
+    int InterpolateEntities(const NetEntity* a, int aCount, const NetEntity* b, int bCount, double t, NetEntity* out)
+    {
+        int ai = 0;
+        for (int i = 0; i < bCount; ++i)
+        {
+            out[i] = b[i];
+            while (ai < aCount && a[ai].id < b[i].id)
+                ai++;
+            if (ai < aCount && a[ai].id == b[i].id)
+            {
+                out[i].x = static_cast<short>(std::lround(Lerp(a[ai].x, b[i].x, t)));
+                out[i].y = static_cast<short>(std::lround(Lerp(a[ai].y, b[i].y, t)));
+            }
+        }
+        return bCount;
+    }
+}
+
+short NetQuantize(double value)
+{
+    double q = std::round(value * NET_POSITION_SCALE);
+    return static_cast<short>(Clamp(q, -32768.0, 32767.0));
+}
+
+double NetDequantize(short value)
+{
+    return value / NET_POSITION_SCALE;
+}
+
+void SnapshotCapture(Snapshot& out, unsigned int tick, unsigned int serverTimeMs)
+{
+    out.tick = tick;
+    out.serverTimeMs = serverTimeMs;
+    out.inputTimeMs = 0;  // 由会话层填入
+
+    out.playerCount = GetPlayerCount();
+    for (int i = 0; i < out.playerCount; ++i)
+    {
+        const Player* player = GetPlayerByIndex(i);
+        out.players[i].x = NetQuantize(player->position.x);
+        out.players[i].y = NetQuantize(player->position.y);
+        out.players[i].health = player->attributes.health;
+        out.players[i].score = player->attributes.score;
+    }
+
+    out.enemyCount = CaptureEnemies(out);
+    out.bulletCount = CaptureBullets(out);
+
+    // Boss 只同步位置和存活部件：部件布局是固定的，客户端按同样的布局重建
+    out.bossCount = CaptureEntities(GetBosses(), out.bosses, NET_MAX_BOSSES);
+    for (int i = 0; i < out.bossCount; ++i)
+    {
+        for (const Boss& boss : GetBosses())
+        {
+            if (boss.id == out.bosses[i].id)
+                out.bossParts[i] = GetBossPartMask(boss);
+        }
+    }
+}
+
+void SnapshotApply(const Snapshot& snapshot)
+{
+    // 玩家数量与服务器一致（玩家死亡后服务器会重建玩家）
+    SetPlayerCount(snapshot.playerCount);
+    if (GetPlayerCount() != snapshot.playerCount)
+        CreatePlayer();
+    for (int i = 0; i < snapshot.playerCount; ++i)
+    {
+        Player* player = GetPlayerByIndex(i);
+        player->position.x = NetDequantize(snapshot.players[i].x);
+        player->position.y = NetDequantize(snapshot.players[i].y);
+        player->attributes.health = snapshot.players[i].health;
+        player->attributes.score = snapshot.players[i].score;
+    }
+
+    // 直接写入实体数组：保留服务器的编号，不产生生成日志，也不改变生成计时和子弹时钟
+    ClearEnemyReplicas();
+    for (int i = 0; i < snapshot.enemyCount; ++i)
+    {
+        AddEnemyReplica(static_cast<EnemyType>(snapshot.enemyTypes[i]), snapshot.enemies[i].id,
+                        NetDequantize(snapshot.enemies[i].x), NetDequantize(snapshot.enemies[i].y));
+    }
+
+    ClearBulletReplicas();
+    for (int i = 0; i < snapshot.bulletCount; ++i)
+    {
+        int owner = snapshot.bulletEnemy[i] ? ENEMY_BULLET_OWNER : 0;
+        AddBulletReplica(snapshot.bullets[i].id, NetDequantize(snapshot.bullets[i].x),
+                         NetDequantize(snapshot.bullets[i].y), owner);
+    }
+
+    // Boss 按编号原地更新，只有新出现的 Boss 才重建部件布局
+    for (int i = 0; i < snapshot.bossCount; ++i)
+    {
+        SetBossReplica(i, snapshot.bosses[i].id, NetDequantize(snapshot.bosses[i].x),
+                       NetDequantize(snapshot.bosses[i].y), snapshot.bossParts[i]);
+    }
+    TruncateBossReplicas(snapshot.bossCount);
+}
+
+void SnapshotSpawnRemovalEffects(const Snapshot& before, const Snapshot& after)
+{
+    // 敌机：编号从 after 中消失、且最后位置仍在屏幕内的视为被击毁（离开屏幕的不算）
+    int ai = 0;
+    for (int i = 0; i < before.enemyCount; ++i)
+    {
+        const NetEntity& e = before.enemies[i];
+        while (ai < after.enemyCount && after.enemies[ai].id < e.id)
+            ai++;
+        if (ai < after.enemyCount && after.enemies[ai].id == e.id)
+            continue;
+        Vector2 center = {NetDequantize(e.x) + ENEMY_WIDTH / 2.0, NetDequantize(e.y) + ENEMY_HEIGHT / 2.0};
+        if (!IsOnScreen(center))
+            continue;
+        SpawnExplosion(center.x, center.y);
+        AudioPlay(SOUND_EXPLOSION, 0.8f, AudioPanForX(center.x));
+    }
+
+    // 子弹：在屏幕内消失的视为命中（子弹数达到同步上限时列表会被截断，此时无法区分，跳过）
+    if (before.bulletCount < NET_MAX_BULLETS && after.bulletCount < NET_MAX_BULLETS)
+    {
+        int bi = 0;
+        for (int i = 0; i < before.bulletCount; ++i)
+        {
+            const NetEntity& b = before.bullets[i];
+            while (bi < after.bulletCount && after.bullets[bi].id < b.id)
+                bi++;
+            if (bi < after.bulletCount && after.bullets[bi].id == b.id)
+                continue;
+            Vector2 center = {NetDequantize(b.x), NetDequantize(b.y)};
+            if (!IsOnScreen(center))
+                continue;
+            SpawnHitSparks(center.x, center.y);
+            AudioPlay(SOUND_HIT, 0.6f, AudioPanForX(center.x));
+        }
+    }
+
+    // Boss：部件位置取自当前画面上的 Boss（布局只在游戏世界中）；
+    // 被击毁的部件各自爆炸，整个 Boss 消失时剩余的存活部件一起爆炸
+    for (const Boss& boss : GetBosses())
+    {
+        int bi = 0;
+        while (bi < before.bossCount && before.bosses[bi].id != boss.id)
+            bi++;
+        if (bi == before.bossCount)
+            continue;
+        unsigned long long remaining = 0;
+        for (int i = 0; i < after.bossCount; ++i)
+        {
+            if (after.bosses[i].id == boss.id)
+                remaining = after.bossParts[i];
+        }
+        unsigned long long lost = before.bossParts[bi] & ~remaining;
+        for (int i = 0; i < boss.partCount; ++i)
+        {
+            if (!((lost >> i) & 1u))
+                continue;
+            Vector2 center = GetBossPartCenter(boss.parts[i]);
+            SpawnExplosion(center.x, center.y);
+            AudioPlay(SOUND_EXPLOSION, 0.8f, AudioPanForX(center.x));
+        }
+    }
+}
+
+void SnapshotInterpolate(const Snapshot& a, const Snapshot& b, double t, Snapshot& out)
+{
+    out.tick = b.tick;
+    out.serverTimeMs = static_cast<unsigned int>(Lerp(a.serverTimeMs, b.serverTimeMs, t));
+    out.inputTimeMs = a.inputTimeMs;  // 画面完整包含的是 a 的状态
+
+    out.playerCount = b.playerCount;
+    for (int i = 0; i < b.playerCount; ++i)
+    {
+        out.players[i] = b.players[i];
+        if (i < a.playerCount)
+        {
+            out.players[i].x = static_cast<short>(std::lround(Lerp(a.players[i].x, b.players[i].x, t)));
+            out.players[i].y = static_cast<short>(std::lround(Lerp(a.players[i].y, b.players[i].y, t)));
+        }
+    }
+
+    out.enemyCount = InterpolateEntities(a.enemies, a.enemyCount, b.enemies, b.enemyCount, t, out.enemies);
+    std::copy(b.enemyTypes, b.enemyTypes + b.enemyCount, out.enemyTypes);
+    out.bulletCount = InterpolateEntities(a.bullets, a.bulletCount, b.bullets, b.bulletCount, t, out.bullets);
+    std::copy(b.bulletEnemy, b.bulletEnemy + b.bulletCount, out.bulletEnemy);
+    out.bossCount = InterpolateEntities(a.bosses, a.bossCount, b.bosses, b.bossCount, t, out.bosses);
+    for (int i = 0; i < b.bossCount; ++i)
+        out.bossParts[i] = b.bossParts[i];
+}
+
+int SnapshotEncode(const Snapshot& current, const Snapshot* base, unsigned char* buffer, int capacity)
+{
+    BitWriter w = {buffer, capacity, 0, false};
+
+    WriteBits(w, current.tick, 32);
+    WriteBits(w, current.serverTimeMs, 32);
+
+    // 玩家：坐标差值 + 生命值 + 得分（得分不变时只写 1 位）
+    WriteBits(w, static_cast<unsigned int>(current.playerCount), 2);
+    for (int i = 0; i < current.playerCount; ++i)
+    {
+        const NetPlayer& p = current.players[i];
+        const NetPlayer* bp = (base && i < base->playerCount) ? &base->players[i] : nullptr;
+        WriteDelta(w, p.x - (bp ? bp->x : 0));
+        WriteDelta(w, p.y - (bp ? bp->y : 0));
+        WriteBits(w, static_cast<unsigned int>(p.health) & 0xFFu, 8);
+        if (bp && bp->score == p.score)
+            WriteBits(w, 0, 1);
+        else
+        {
+            WriteBits(w, 1, 1);
+            WriteBits(w, static_cast<unsigned int>(p.score), 32);
+        }
+    }
+
+    WriteEntities(w, current.enemies, current.enemyCount, base ? base->enemies : nullptr, base ? base->enemyCount : 0);
+    WriteNewTags(w, current.enemies, current.enemyTypes, current.enemyCount, base ? base->enemies : nullptr,
+                 base ? base->enemyCount : 0, kEnemyTypeBits);
+    WriteEntities(w, current.bullets, current.bulletCount, base ? base->bullets : nullptr, base ? base->bulletCount : 0);
+    WriteNewTags(w, current.bullets, current.bulletEnemy, current.bulletCount, base ? base->bullets : nullptr,
+                 base ? base->bulletCount : 0, 1);
+    WriteEntities(w, current.bosses, current.bossCount, base ? base->bosses : nullptr, base ? base->bossCount : 0);
+    for (int i = 0; i < current.bossCount; ++i)
+    {
+        // 部件掩码与基准中同一个 Boss 相同时只写 1 位
+        const unsigned long long* baseMask = FindBossMask(base, current.bosses[i].id);
+        if (baseMask && *baseMask == current.bossParts[i])
+            WriteBits(w, 0, 1);
+        else
+        {
+            WriteBits(w, 1, 1);
+            WriteBits(w, static_cast<unsigned int>(current.bossParts[i]), 32);
+            WriteBits(w, static_cast<unsigned int>(current.bossParts[i] >> 32), 32);
+        }
+    }
+
+    if (w.overflow)
+        return -1;
+    return (w.bitPos + 7) / 8;
+}
+
+bool SnapshotDecode(const unsigned char* buffer, int size, const Snapshot* base, Snapshot& out)
+{
+    BitReader r = {buffer, size, 0, false};
+
+    out.tick = ReadBits(r, 32);
+    out.serverTimeMs = ReadBits(r, 32);
+
+    out.playerCount = static_cast<int>(ReadBits(r, 2));
+    if (out.playerCount > MAX_PLAYERS)
+        return false;
+    for (int i = 0; i < out.playerCount; ++i)
+    {
+        NetPlayer& p = out.players[i];
+        const NetPlayer* bp = (base && i < base->playerCount) ? &base->players[i] : nullptr;
+        p.x = static_cast<short>((bp ? bp->x : 0) + ReadDelta(r));
+        p.y = static_cast<short>((bp ? bp->y : 0) + ReadDelta(r));
+        p.health = static_cast<signed char>(ReadBits(r, 8));
+        if (ReadBits(r, 1))
+            p.score = static_cast<int>(ReadBits(r, 32));
+        else if (bp)
+            p.score = bp->score;
+        else
+            return false;
+    }
+
+    if (!ReadEntities(r, out.enemies, out.enemyCount, NET_MAX_ENEMIES, base ? base->enemies : nullptr, base ? base->enemyCount : 0))
+        return false;
+    if (!ReadNewTags(r, out.enemies, out.enemyTypes, out.enemyCount, base ? base->enemies : nullptr,
+                     base ? base->enemyTypes : nullptr, base ? base->enemyCount : 0, kEnemyTypeBits, ENEMY_TYPE_COUNT))
+        return false;
+    if (!ReadEntities(r, out.bullets, out.bulletCount, NET_MAX_BULLETS, base ? base->bullets : nullptr, base ? base->bulletCount : 0))
+        return false;
+    if (!ReadNewTags(r, out.bullets, out.bulletEnemy, out.bulletCount, base ? base->bullets : nullptr,
+                     base ? base->bulletEnemy : nullptr, base ? base->bulletCount : 0, 1, 2))
+        return false;
+    if (!ReadEntities(r, out.bosses, out.bossCount, NET_MAX_BOSSES, base ? base->bosses : nullptr, base ? base->bossCount : 0))
+        return false;
+    for (int i = 0; i < out.bossCount; ++i)
+    {
+        if (ReadBits(r, 1))
+        {
+            unsigned long long low = ReadBits(r, 32);
+            unsigned long long high = ReadBits(r, 32);
+            out.bossParts[i] = low | high << 32;
+        }
+        else
+        {
+            const unsigned long long* baseMask = FindBossMask(base, out.bosses[i].id);
+            if (!baseMask)
+                return false;  // 基准不一致
+            out.bossParts[i] = *baseMask;
+        }
+    }
+    return !r.overflow;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../util/config.h"
+
+// ===== 联机快照：服务器权威状态的量化表示 =====
+// 坐标按 NET_POSITION_SCALE 量化为 16 位整数，
+// 编码时以客户端最后确认的快照为基准做差分压缩
+
+// 一个被同步的实体（敌人、子弹或 Boss）
+struct NetEntity
+{
+    unsigned int id;  // 实体编号（列表按编号升序排列）
+    short x;          // 量化后的 x 坐标
+    short y;          // 量化后的 y 坐标
+};
+
+// 一个被同步的玩家
+struct NetPlayer
+{
+    short x;             // 量化后的 x 坐标
+    short y;             // 量化后的 y 坐标
+    int health;          // 生命值
+    int score;           // 得分
+};
+
+// 某一个服务器 tick 的完整世界状态
+struct Snapshot
+{
+    unsigned int tick;          // 服务器 tick 编号
+    unsigned int serverTimeMs;  // 生成快照时的服务器时间（毫秒）
+    unsigned int inputTimeMs;   // 已生效的最新客户端输入的发送时间（客户端时钟；走包头，不参与编码）
+    int playerCount;
+    NetPlayer players[MAX_PLAYERS];
+    int enemyCount;
+    NetEntity enemies[NET_MAX_ENEMIES];
+    unsigned char enemyTypes[NET_MAX_ENEMIES];     // 敌机类型 EnemyType（与 enemies 一一对应）
+    int bulletCount;
+    NetEntity bullets[NET_MAX_BULLETS];
+    unsigned char bulletEnemy[NET_MAX_BULLETS];    // 1 = 敌机子弹（与 bullets 一一对应）
+    int bossCount;
+    NetEntity bosses[NET_MAX_BOSSES];
+    unsigned long long bossParts[NET_MAX_BOSSES];  // 存活部件掩码（与 bosses 一一对应）
+};
+
+// 从当前游戏世界采集快照（超出容量的实体被截断）
+void SnapshotCapture(Snapshot& out, unsigned int tick, unsigned int serverTimeMs);
+
+// 将快照写回游戏世界（客户端显示用，没有生成日志、计时器重置等副作用）
+void SnapshotApply(const Snapshot& snapshot);
+
+// 客户端表现：before 中有、after 中已消失的实体在原位置播放命中/爆炸效果
+// （在 SnapshotApply(after) 之前调用，Boss 部件的位置取自当前游戏世界）
+void SnapshotSpawnRemovalEffects(const Snapshot& before, const Snapshot& after);
+
+// 在两个快照之间按 t ∈ [0, 1] 插值（按编号匹配实体，b 中新出现的实体直接使用 b 的位置）
+void SnapshotInterpolate(const Snapshot& a, const Snapshot& b, double t, Snapshot& out);
+
+// 编码快照；base 为 nullptr 时发送完整状态
+// 返回写入的字节数，缓冲区不足时返回 -1
+int SnapshotEncode(const Snapshot& current, const Snapshot* base, unsigned char* buffer, int capacity);
+
+// 解码快照；base 必须与编码时使用的基准相同
+bool SnapshotDecode(const unsigned char* buffer, int size, const Snapshot* base, Snapshot& out);
+
+// 坐标量化/反量化
+short NetQuantize(double value);
+double NetDequantize(short value);
@@ -0,0 +1,148 @@
+#include "socket.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // 把 NetAddress 转换为 sockaddr_in（网络字节序）
+    sockaddr_in ToSockAddr(const NetAddress& address)
+    {
+        sockaddr_in sa;
+        std::memset(&sa, 0, sizeof(sa));
+        sa.sin_family = AF_INET;
+        sa.sin_addr.s_addr = htonl(address.ip);
+        sa.sin_port = htons(address.port);
+        return sa;
+    }
+
+    // 最近一次错误是否只是"暂时没有数据"
+    bool WouldBlock()
+    {
+#ifdef _WIN32
+        return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+    }
+}
+
+bool NetSocketStartup()
+{
+#ifdef _WIN32
+    WSADATA data;
+    return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+#else
+    return true;
+#endif
+}
+
+void NetSocketCleanup()
+{
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+NetSocket NetSocketOpen(unsigned short port)
+{
+#ifdef _WIN32
+    SOCKET s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET)
+        return -1;
+#else
+    int s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s < 0)
+        return -1;
+#endif
+
+    // 绑定到所有本地地址的指定端口
+    NetAddress any = {0, port};
+    sockaddr_in sa = ToSockAddr(any);
+    if (bind(s, reinterpret_cast<const sockaddr*>(&sa), sizeof(sa)) != 0)
+    {
+        NetSocketClose(static_cast<NetSocket>(s));
+        return -1;
+    }
+
+    // 设置为非阻塞，游戏循环每帧轮询
+#ifdef _WIN32
+    u_long nonBlocking = 1;
+    ioctlsocket(s, FIONBIO, &nonBlocking);
+#else
+    fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+#endif
+    return static_cast<NetSocket>(s);
+}
+
+void NetSocketClose(NetSocket sock)
+{
+    if (sock < 0)
+        return;
+#ifdef _WIN32
+    closesocket(static_cast<SOCKET>(sock));
+#else
+    close(static_cast<int>(sock));
+#endif
+}
+
+int NetSocketSend(NetSocket sock, const NetAddress& to, const void* data, int size)
+{
+    if (sock < 0)
+        return -1;
+    sockaddr_in sa = ToSockAddr(to);
+    int sent = static_cast<int>(sendto(sock, static_cast<const char*>(data), size, 0,
+                                       reinterpret_cast<const sockaddr*>(&sa), sizeof(sa)));
+    return sent < 0 ? -1 : sent;
+}
+
+int NetSocketReceive(NetSocket sock, NetAddress& from, void* data, int capacity)
+{
+    if (sock < 0)
+        return -1;
+    sockaddr_in sa;
+    socklen_t len = sizeof(sa);
+    int received = static_cast<int>(recvfrom(sock, static_cast<char*>(data), capacity, 0,
+                                             reinterpret_cast<sockaddr*>(&sa), &len));
+    if (received < 0)
+        return WouldBlock() ? 0 : -1;
+
+    from.ip = ntohl(sa.sin_addr.s_addr);
+    from.port = ntohs(sa.sin_port);
+    return received;
+}
+
+bool NetResolveAddress(const char* host, unsigned short port, NetAddress& out)
+{
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host, nullptr, &hints, &result) != 0 || !result)
+        return false;
+
+    const sockaddr_in* sa = reinterpret_cast<const sockaddr_in*>(result->ai_addr);
+    out.ip = ntohl(sa->sin_addr.s_addr);
+    out.port = port;
+    freeaddrinfo(result);
+    return true;
+}
+
+bool NetAddressEqual(const NetAddress& a, const NetAddress& b)
+{
+    return a.ip == b.ip && a.port == b.port;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+// 非阻塞 UDP 套接字的轻量封装（POSIX / Winsock）
+
+// 套接字句柄（-1 表示无效）
+typedef intptr_t NetSocket;
+
+// IPv4 地址（主机字节序）
+struct NetAddress
+{
+    unsigned int ip;      // IPv4 地址，例如 127.0.0.1 = 0x7F000001
+    unsigned short port;  // 端口
+};
+
+// 初始化/清理套接字库（Windows 上需要 WSAStartup）
+bool NetSocketStartup();
+void NetSocketCleanup();
+
+// 打开一个绑定到指定端口的非阻塞 UDP 套接字（port = 0 时由系统分配）
+// 失败返回 -1
+NetSocket NetSocketOpen(unsigned short port);
+
+// 关闭套接字
+void NetSocketClose(NetSocket sock);
+
+// 发送一个数据包，返回发送的字节数，失败返回 -1
+int NetSocketSend(NetSocket sock, const NetAddress& to, const void* data, int size);
+
+// 接收一个数据包，返回接收的字节数；没有数据时返回 0，出错返回 -1
+int NetSocketReceive(NetSocket sock, NetAddress& from, void* data, int capacity);
+
+// 解析主机名或点分十进制地址
+bool NetResolveAddress(const char* host, unsigned short port, NetAddress& out);
+
+// 判断两个地址是否相同
+bool NetAddressEqual(const NetAddress& a, const NetAddress& b);
@@ -0,0 +1,205 @@
+#include "background.h"
+
+#include "../util/config.h"
+
+#include <SDL.h>
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    enum LayerKind
+    {
+        LAYER_STARS = 0,
+        LAYER_CLOUDS
+    };
+
+    // 一层的外观：密度按每 10 万像素计，方便在不同输出尺寸下保持一致
+    struct LayerStyle
+    {
+        LayerKind kind;
+        double speed;       // 滚动速度（像素/秒），越近越快
+        int density;        // 每 10 万像素的星星 / 云团数量
+        int minSize;        // 星星边长 / 云团半径（像素）
+        int maxSize;
+        Uint8 r, g, b;
+        Uint8 alpha;        // 最亮处的不透明度
+        unsigned int seed;
+    };
+
+    constexpr LayerStyle kLayers[] = {
+        {LAYER_STARS, 12.0, 60, 1, 1, 150, 150, 190, 160, 0x9E3779B9u},
+        {LAYER_STARS, 30.0, 25, 1, 2, 200, 200, 230, 210, 0x85EBCA6Bu},
+        {LAYER_STARS, 70.0, 8, 2, 3, 255, 255, 255, 255, 0xC2B2AE35u},
+        {LAYER_CLOUDS, 140.0, 2, 30, 80, 120, 140, 170, 40, 0x27D4EB2Fu},
+    };
+    static_assert(sizeof(kLayers) / sizeof(kLayers[0]) == BACKGROUND_LAYERS, "One style per background layer");
+
+    SDL_Texture* g_textures[BACKGROUND_LAYERS] = {};
+    SDL_Renderer* g_renderer = nullptr;   // 生成纹理时使用的渲染器
+    int g_width = 0;                      // 生成纹理时的输出尺寸
+    int g_height = 0;
+    int g_layerCount = BACKGROUND_LAYERS;
+    double g_time = 0.0;
+    // 生成用的像素缓冲（所有层共用）
+    std::vector<Uint32> g_pixels;
+
+    // xorshift32：每层从固定种子开始，生成结果与游戏随机数无关
+    unsigned int NextRandom(unsigned int& state)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    int RandomRange(unsigned int& state, int min, int max)
+    {
+        return min + static_cast<int>(NextRandom(state) % static_cast<unsigned int>(max - min + 1));
+    }
+
+    // 按透明度叠加一个像素（坐标在两个方向上都取模，纹理左右、上下都首尾相接）
+    void BlendPixel(int x, int y, const LayerStyle& style, int alpha)
+    {
+        x = ((x % g_width) + g_width) % g_width;
+        y = ((y % g_height) + g_height) % g_height;
+        Uint32& p = g_pixels[static_cast<size_t>(y) * g_width + x];
+        int a = static_cast<int>(p >> 24);
+        if (alpha > a)
+            p = (static_cast<Uint32>(alpha) << 24) | (style.r << 16) | (style.g << 8) | style.b;
+    }
+
+    void GenerateStars(const LayerStyle& style, unsigned int& state, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            int x = RandomRange(state, 0, g_width - 1);
+            int y = RandomRange(state, 0, g_height - 1);
+            int size = RandomRange(state, style.minSize, style.maxSize);
+            // 亮度在 50%～100% 之间随机
+            int alpha = style.alpha / 2 + RandomRange(state, 0, style.alpha / 2);
+            for (int dy = 0; dy < size; ++dy)
+                for (int dx = 0; dx < size; ++dx)
+                    BlendPixel(x + dx, y + dy, style, alpha);
+        }
+    }
+
+    // 云团：中心最浓、向边缘平方衰减的圆
+    void GenerateClouds(const LayerStyle& style, unsigned int& state, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            int cx = RandomRange(state, 0, g_width - 1);
+            int cy = RandomRange(state, 0, g_height - 1);
+            int radius = RandomRange(state, style.minSize, style.maxSize);
+            for (int dy = -radius; dy <= radius; ++dy)
+            {
+                for (int dx = -radius; dx <= radius; ++dx)
+                {
+                    double d = (dx * dx + dy * dy) / static_cast<double>(radius * radius);
+                    if (d < 1.0)
+                        BlendPixel(cx + dx, cy + dy, style, static_cast<int>(style.alpha * (1.0 - d) * (1.0 - d)));
+                }
+            }
+        }
+    }
+
+    void DestroyTextures()
+    {
+        for (SDL_Texture*& texture : g_textures)
+        {
+            if (texture)
+                SDL_DestroyTexture(texture);
+            texture = nullptr;
+        }
+    }
+
+    // 生成第 layer 层的纹理（已存在时直接返回）
+    SDL_Texture* EnsureLayer(SDL_Renderer* renderer, int layer)
+    {
+        if (g_textures[layer])
+            return g_textures[layer];
+
+        const LayerStyle& style = kLayers[layer];
+        g_pixels.assign(static_cast<size_t>(g_width) * g_height, 0u);
+        unsigned int state = style.seed;
+        int count = static_cast<int>(static_cast<long long>(g_width) * g_height * style.density / 100000);
+        if (style.kind == LAYER_STARS)
+            GenerateStars(style, state, count);
+        else
+            GenerateClouds(style, state, count);
+
+        SDL_Texture* texture =
+            SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, g_width, g_height);
+        if (!texture)
+        {
+            SDL_Log("BackgroundRender: SDL_CreateTexture failed - %s", SDL_GetError());
+            return nullptr;
+        }
+        SDL_UpdateTexture(texture, nullptr, g_pixels.data(), g_width * static_cast<int>(sizeof(Uint32)));
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        g_textures[layer] = texture;
+        return texture;
+    }
+}
+
+void BackgroundUpdate(double deltaTime)
+{
+    g_time += deltaTime;
+}
+
+void BackgroundRender(SDL_Renderer* renderer)
+{
+    if (!renderer || g_layerCount == 0)
+        return;
+
+    // 渲染器或输出尺寸变化时丢弃旧纹理，各层在下面按需重新生成
+    int width = 0, height = 0;
+    if (SDL_GetRendererOutputSize(renderer, &width, &height) != 0 || width <= 0 || height <= 0)
+        return;
+    if (renderer != g_renderer || width != g_width || height != g_height)
+    {
+        DestroyTextures();
+        g_renderer = renderer;
+        g_width = width;
+        g_height = height;
+    }
+
+    for (int layer = 0; layer < g_layerCount; ++layer)
+    {
+        SDL_Texture* texture = EnsureLayer(renderer, layer);
+        if (!texture)
+            return;
+
+        // 纹理向下滚动：上面一份接在下面一份的顶部
+        int offset = static_cast<int>(std::fmod(g_time * kLayers[layer].speed, static_cast<double>(g_height)));
+        SDL_Rect lower = {0, offset, g_width, g_height};
+        SDL_RenderCopy(renderer, texture, nullptr, &lower);
+        if (offset > 0)
+        {
+            SDL_Rect upper = {0, offset - g_height, g_width, g_height};
+            SDL_RenderCopy(renderer, texture, nullptr, &upper);
+        }
+    }
+}
+
+void SetBackgroundLayerCount(int count)
+{
+    g_layerCount = count < 0 ? 0 : (count > BACKGROUND_LAYERS ? BACKGROUND_LAYERS : count);
+}
+
+int GetBackgroundLayerCount()
+{
+    return g_layerCount;
+}
+
+void BackgroundShutdown()
+{
+    DestroyTextures();
+    g_renderer = nullptr;
+    g_width = 0;
+    g_height = 0;
+    g_pixels.clear();
+    g_pixels.shrink_to_fit();
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+struct SDL_Renderer;
+
+// ===== 视差滚动背景 =====
+// 每一层（远处星空 → 近处云层）在第一次绘制时生成一张上下首尾相接的纹理，之后每帧只按各自的速度
+// 计算纵向偏移，用两次 SDL_RenderCopy 拼出整屏，不逐颗绘制星星。
+// 渲染器或输出尺寸变化（窗口缩放）时纹理按新尺寸重新生成；被关闭的层在重新启用前不会生成。
+// 生成使用每层固定种子的独立随机数，不影响游戏逻辑的随机序列
+
+// 推进滚动时间（每个 tick 调用）
+void BackgroundUpdate(double deltaTime);
+
+// 绘制启用的各层（从远到近），在清屏之后、游戏对象之前调用
+void BackgroundRender(SDL_Renderer* renderer);
+
+// 设置启用的层数（从最远的一层算起，超出范围时截断到 [0, BACKGROUND_LAYERS]）
+void SetBackgroundLayerCount(int count);
+
+// 当前启用的层数
+int GetBackgroundLayerCount();
+
+// 释放所有层的纹理（渲染器销毁前调用）
+void BackgroundShutdown();
@@ -0,0 +1,148 @@
+#include "sprite_atlas.h"
+
+#include <SDL.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const char* const kSpriteNames[SPRITE_COUNT] = {"player", "player2", "enemy", "enemy_zigzag", "enemy_diver",
+                                                     "enemy_tank", "enemy_shooter", "bullet", "enemy_bullet"};
+
+    // 图集数据
+    Sprite g_sprites[SPRITE_COUNT] = {};
+    std::vector<unsigned char> g_pixels;  // RGBA 像素
+    int g_width = 0;
+    int g_height = 0;
+    bool g_loaded = false;
+
+    unsigned int ReadU16(const unsigned char* p)
+    {
+        return p[0] | (p[1] << 8);
+    }
+
+    unsigned int ReadU32(const unsigned char* p)
+    {
+        return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<unsigned int>(p[3]) << 24);
+    }
+
+    float ReadF32(const unsigned char* p)
+    {
+        unsigned int bits = ReadU32(p);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // 解析图集文件内容
+    bool Parse(const unsigned char* data, size_t size)
+    {
+        if (size < SPRITE_ATLAS_HEADER_SIZE || ReadU32(data) != SPRITE_ATLAS_MAGIC ||
+            ReadU32(data + 4) != SPRITE_ATLAS_VERSION)
+            return false;
+
+        g_width = static_cast<int>(ReadU32(data + 8));
+        g_height = static_cast<int>(ReadU32(data + 12));
+        unsigned int count = ReadU32(data + 16);
+        size_t pixelOffset = SPRITE_ATLAS_HEADER_SIZE + static_cast<size_t>(count) * SPRITE_ATLAS_ENTRY_SIZE;
+        size_t pixelBytes = static_cast<size_t>(g_width) * g_height * 4;
+        if (size < pixelOffset + pixelBytes)
+            return false;
+
+        // 按名称把元数据表映射到 SpriteId
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            const unsigned char* entry = data + SPRITE_ATLAS_HEADER_SIZE + i * SPRITE_ATLAS_ENTRY_SIZE;
+            char name[SPRITE_NAME_LENGTH + 1] = {};
+            std::memcpy(name, entry, SPRITE_NAME_LENGTH);
+
+            for (int id = 0; id < SPRITE_COUNT; ++id)
+            {
+                if (std::strcmp(name, kSpriteNames[id]) != 0)
+                    continue;
+                Sprite& s = g_sprites[id];
+                s.x = static_cast<int>(ReadU16(entry + 16));
+                s.y = static_cast<int>(ReadU16(entry + 18));
+                s.w = static_cast<int>(ReadU16(entry + 20));
+                s.h = static_cast<int>(ReadU16(entry + 22));
+                s.pivotX = ReadF32(entry + 24);
+                s.pivotY = ReadF32(entry + 28);
+                s.u0 = static_cast<float>(s.x) / g_width;
+                s.v0 = static_cast<float>(s.y) / g_height;
+                s.u1 = static_cast<float>(s.x + s.w) / g_width;
+                s.v1 = static_cast<float>(s.y + s.h) / g_height;
+                s.valid = true;
+            }
+        }
+
+        g_pixels.assign(data + pixelOffset, data + pixelOffset + pixelBytes);
+        return true;
+    }
+}
+
+const char* GetSpriteName(SpriteId id)
+{
+    return (id >= 0 && id < SPRITE_COUNT) ? kSpriteNames[id] : "";
+}
+
+bool SpriteAtlasLoad()
+{
+    SpriteAtlasUnload();
+
+    // 图集由构建生成在可执行文件旁边，其次尝试当前目录
+    char* basePath = SDL_GetBasePath();
+    std::string primary = basePath ? std::string(basePath) + SPRITE_ATLAS_FILE : std::string(SPRITE_ATLAS_FILE);
+    if (basePath)
+        SDL_free(basePath);
+
+    size_t size = 0;
+    void* data = SDL_LoadFile(primary.c_str(), &size);
+    if (!data)
+        data = SDL_LoadFile(SPRITE_ATLAS_FILE, &size);
+    if (!data)
+    {
+        SDL_Log("SpriteAtlasLoad: %s not found, using primitive rendering", SPRITE_ATLAS_FILE);
+        return false;
+    }
+
+    g_loaded = Parse(static_cast<const unsigned char*>(data), size);
+    SDL_free(data);
+    if (!g_loaded)
+    {
+        SDL_Log("SpriteAtlasLoad: %s is corrupt or has an unknown version", SPRITE_ATLAS_FILE);
+        SpriteAtlasUnload();
+    }
+    return g_loaded;
+}
+
+void SpriteAtlasUnload()
+{
+    for (Sprite& s : g_sprites)
+        s = {};
+    g_pixels.clear();
+    g_pixels.shrink_to_fit();
+    g_width = 0;
+    g_height = 0;
+    g_loaded = false;
+}
+
+bool SpriteAtlasIsLoaded()
+{
+    return g_loaded;
+}
+
+const Sprite* GetSprite(SpriteId id)
+{
+    if (!g_loaded || id < 0 || id >= SPRITE_COUNT || !g_sprites[id].valid)
+        return nullptr;
+    return &g_sprites[id];
+}
+
+const unsigned char* GetSpriteAtlasPixels(int& width, int& height)
+{
+    width = g_width;
+    height = g_height;
+    return g_loaded ? g_pixels.data() : nullptr;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+// ===== 精灵图集 =====
+// tools/atlas_packer 在构建时把 resource/ 中的 PNG 装箱成一张图集，
+// 连同元数据表（UV 矩形、锚点）写入 sprites.atlas；
+// 碰撞粗测仍用 config.h 中的实体尺寸，精确检测用由透明度生成的遮罩（见 collision_mask.h）
+// 游戏启动时只读取这一个文件，所有精灵都从同一张纹理绘制
+
+// ----- 文件格式（小端） -----
+// 文件头：magic(4) version(4) width(4) height(4) spriteCount(4)
+// 元数据：每个精灵 name(16) x y w h(各 2) pivotX pivotY(各 4, float)
+// 像素：width * height 个 RGBA 像素（每像素 4 字节，依次为 R G B A）
+#define SPRITE_ATLAS_MAGIC 0x54414341u   // "ACAT"
+#define SPRITE_ATLAS_VERSION 4
+#define SPRITE_ATLAS_FILE "sprites.atlas"
+#define SPRITE_NAME_LENGTH 16
+#define SPRITE_ATLAS_HEADER_SIZE 20
+#define SPRITE_ATLAS_ENTRY_SIZE 32
+
+// 游戏使用的精灵（名称与 PNG 文件名一致，例如 player.png）
+// 敌机精灵按 EnemyType 的顺序排列，SPRITE_ENEMY + type 即该类型的精灵
+enum SpriteId
+{
+    SPRITE_PLAYER,         // 玩家 1
+    SPRITE_PLAYER2,        // 玩家 2
+    SPRITE_ENEMY,          // 基础型敌机
+    SPRITE_ENEMY_ZIGZAG,   // 之字形敌机
+    SPRITE_ENEMY_DIVER,    // 俯冲型敌机
+    SPRITE_ENEMY_TANK,     // 重装型敌机
+    SPRITE_ENEMY_SHOOTER,  // 射手
+    SPRITE_BULLET,         // 玩家子弹
+    SPRITE_ENEMY_BULLET,   // 敌机子弹
+    SPRITE_COUNT
+};
+
+// 一个精灵在图集中的信息
+struct Sprite
+{
+    int x, y, w, h;          // 图集中的像素矩形
+    float u0, v0, u1, v1;    // 归一化 UV 矩形
+    double pivotX, pivotY;   // 锚点（精灵内的像素坐标，对齐到游戏对象的 position）
+    bool valid;              // 图集中是否有该精灵
+};
+
+// 精灵名称（与 SpriteId 一一对应）
+const char* GetSpriteName(SpriteId id);
+
+// 读取图集文件（像素保留在内存中，纹理在第一次绘制时创建）
+// 找不到文件时返回 false，游戏退回到纯色图元绘制
+bool SpriteAtlasLoad();
+
+// 释放图集及其纹理
+void SpriteAtlasUnload();
+
+// 图集是否已加载
+bool SpriteAtlasIsLoaded();
+
+// 获取精灵信息（未加载或不存在时返回 nullptr）
+const Sprite* GetSprite(SpriteId id);
+
+// 图集的 RGBA 像素（供生成碰撞遮罩等使用），width/height 返回尺寸
+const unsigned char* GetSpriteAtlasPixels(int& width, int& height);
@@ -0,0 +1,107 @@
+#include "sprite_batch.h"
+
+#include "../util/config.h"
+
+#include <SDL.h>
+
+#include <vector>
+
+namespace
+{
+    // 图集纹理（第一次绘制时从图集像素创建）
+    SDL_Texture* g_texture = nullptr;
+    SDL_Renderer* g_textureRenderer = nullptr;
+
+    // 本帧收集的顶点与索引（容量只增不减，稳定后不再分配）
+    std::vector<SDL_Vertex> g_vertices;
+    std::vector<int> g_indices;
+    bool g_active = false;
+
+    bool EnsureTexture(SDL_Renderer* renderer)
+    {
+        if (g_texture && g_textureRenderer == renderer)
+            return true;
+        if (g_texture)
+            SDL_DestroyTexture(g_texture);
+        g_texture = nullptr;
+
+        int width = 0, height = 0;
+        const unsigned char* pixels = GetSpriteAtlasPixels(width, height);
+        if (!pixels)
+            return false;
+
+        g_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, width, height);
+        g_textureRenderer = renderer;
+        if (!g_texture)
+        {
+            SDL_Log("SpriteBatchBegin: SDL_CreateTexture failed - %s", SDL_GetError());
+            return false;
+        }
+        SDL_UpdateTexture(g_texture, nullptr, pixels, width * 4);
+        SDL_SetTextureBlendMode(g_texture, SDL_BLENDMODE_BLEND);
+        return true;
+    }
+}
+
+bool SpriteBatchBegin(SDL_Renderer* renderer)
+{
+    // 第一次使用时按可能出现的精灵总数预留容量（与实体数组的预留容量一致）
+    if (g_vertices.capacity() == 0)
+    {
+        const size_t sprites = MAX_PLAYERS + ENEMY_CAPACITY + BULLET_CAPACITY;
+        g_vertices.reserve(sprites * 4);
+        g_indices.reserve(sprites * 6);
+    }
+    g_vertices.clear();
+    g_indices.clear();
+    g_active = renderer && SpriteAtlasIsLoaded() && EnsureTexture(renderer);
+    return g_active;
+}
+
+bool SpriteBatchIsActive()
+{
+    return g_active;
+}
+
+void SpriteBatchAdd(SpriteId id, double x, double y)
+{
+    const Sprite* sprite = GetSprite(id);
+    if (!g_active || !sprite)
+        return;
+
+    float left = static_cast<float>(x - sprite->pivotX);
+    float top = static_cast<float>(y - sprite->pivotY);
+    float right = left + sprite->w;
+    float bottom = top + sprite->h;
+    SDL_Color white{255, 255, 255, 255};
+
+    // 两个三角形组成一个四边形
+    int base = static_cast<int>(g_vertices.size());
+    g_vertices.push_back({{left, top}, white, {sprite->u0, sprite->v0}});
+    g_vertices.push_back({{right, top}, white, {sprite->u1, sprite->v0}});
+    g_vertices.push_back({{right, bottom}, white, {sprite->u1, sprite->v1}});
+    g_vertices.push_back({{left, bottom}, white, {sprite->u0, sprite->v1}});
+    const int quad[6] = {0, 1, 2, 0, 2, 3};
+    for (int i : quad)
+        g_indices.push_back(base + i);
+}
+
+void SpriteBatchFlush(SDL_Renderer* renderer)
+{
+    if (g_active && renderer && !g_indices.empty())
+    {
+        SDL_RenderGeometry(renderer, g_texture, g_vertices.data(), static_cast<int>(g_vertices.size()),
+                           g_indices.data(), static_cast<int>(g_indices.size()));
+    }
+    g_active = false;
+}
+
+void SpriteBatchShutdown()
+{
+    if (g_texture)
+        SDL_DestroyTexture(g_texture);
+    g_texture = nullptr;
+    g_textureRenderer = nullptr;
+    g_vertices.clear();
+    g_indices.clear();
+}
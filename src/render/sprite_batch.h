@@ -0,0 +1,23 @@
+#pragma once
+
+#include "sprite_atlas.h"
+
+struct SDL_Renderer;
+
+// ===== 精灵批量绘制 =====
+// 一帧内所有精灵先收集为顶点，最后用一次 SDL_RenderGeometry 提交（同一张图集纹理）
+
+// 开始收集本帧的精灵；图集不可用时返回 false（调用方改用图元绘制）
+bool SpriteBatchBegin(SDL_Renderer* renderer);
+
+// 本帧是否正在使用精灵批量绘制
+bool SpriteBatchIsActive();
+
+// 添加一个精灵，(x, y) 对齐到精灵的锚点，按原始像素尺寸绘制
+void SpriteBatchAdd(SpriteId id, double x, double y);
+
+// 提交本帧收集的全部精灵（一次绘制调用）
+void SpriteBatchFlush(SDL_Renderer* renderer);
+
+// 释放纹理（渲染器销毁前调用）
+void SpriteBatchShutdown();
@@ -1,75 +1,120 @@
 #include "hud.h"
 
+#include "hud_font.h"
+
 #include "../util/config.h"
 
 #include <SDL.h>
-#include <SDL_ttf.h>
 
-#include <string>
+#include <cstdio>
+#include <vector>
 
 namespace
 {
-    TTF_Font* g_hudFont = nullptr;
+    // 字体图集纹理（首次绘制时由烘焙数据创建，之后每帧复用）
+    SDL_Texture* g_fontTexture = nullptr;
+    // 创建纹理时使用的渲染器
+    SDL_Renderer* g_fontRenderer = nullptr;
+
+    // 文字刷新节奏：每 g_refreshInterval 帧重新格式化一次
+    int g_refreshInterval = 1;
+    int g_frameCounter = 0;
+    bool g_refreshFrame = true;
+    char g_scoreText[32] = "";
+
+    // 确保字体纹理已为当前渲染器创建
+    bool EnsureFontTexture(SDL_Renderer* renderer)
+    {
+        if (g_fontTexture && g_fontRenderer == renderer)
+            return true;
+        if (g_fontTexture)
+            SDL_DestroyTexture(g_fontTexture);
+
+        // 把 4 位透明度展开成白色 ARGB 像素，颜色在绘制时用 ColorMod 调整
+        const HudFontAtlas& atlas = GetHudFontAtlas();
+        std::vector<Uint32> pixels(static_cast<size_t>(atlas.width) * atlas.height);
+        for (size_t i = 0; i < pixels.size(); ++i)
+        {
+            unsigned int nibble = (atlas.pixels[i / 2] >> ((i & 1) ? 4 : 0)) & 0xFu;
+            pixels[i] = ((nibble * 17u) << 24) | 0x00FFFFFFu;
+        }
+
+        g_fontTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                          atlas.width, atlas.height);
+        g_fontRenderer = renderer;
+        if (!g_fontTexture)
+        {
+            SDL_Log("HudRender: SDL_CreateTexture failed - %s", SDL_GetError());
+            return false;
+        }
+        SDL_UpdateTexture(g_fontTexture, nullptr, pixels.data(), atlas.width * static_cast<int>(sizeof(Uint32)));
+        SDL_SetTextureBlendMode(g_fontTexture, SDL_BLENDMODE_BLEND);
+        return true;
+    }
 }
 
+// 字形已在构建时烘焙进程序：初始化不读取文件，也不加载 SDL_ttf
+// 纹理需要渲染器，推迟到第一次绘制时创建
 void HudInit()
 {
-    if (TTF_Init() != 0) {
-        SDL_Log("HudInit: TTF_Init() failed");
-        return;
-    }
-
-    char* basePath = SDL_GetBasePath();
-    std::string base = basePath ? std::string(basePath) : std::string();
-    if (basePath)
-        SDL_free(basePath);
-
-    std::string pathA = base + "resource/simhei.ttf";
-    std::string pathB = base + "../resource/simhei.ttf";
-    const char* candidates[] = {
-        pathA.c_str(),
-        pathB.c_str(),
-        "resource/simhei.ttf"
-    };
-
-    for (const char* path : candidates) {
-        g_hudFont = TTF_OpenFont(path, 24);
-        if (g_hudFont)
-            return;
-    }
-
-    SDL_Log("HudInit: Failed to load font from resource paths - %s", TTF_GetError());
+    // 无需任何加载工作
 }
 
 void HudShutdown()
 {
-    if (g_hudFont)
+    if (g_fontTexture)
     {
-        TTF_CloseFont(g_hudFont);
-        g_hudFont = nullptr;
+        SDL_DestroyTexture(g_fontTexture);
+        g_fontTexture = nullptr;
     }
-    TTF_Quit();
+    g_fontRenderer = nullptr;
 }
 
 void HudRender(SDL_Renderer* renderer, int score)
 {
-    if (!renderer || !g_hudFont)
-        return;
+    g_refreshFrame = g_frameCounter == 0 || !g_scoreText[0];
+    if (++g_frameCounter >= g_refreshInterval)
+        g_frameCounter = 0;
 
-    std::string text = "Score: " + std::to_string(score);
-    SDL_Color color{COLOR_WHITE.r, COLOR_WHITE.g, COLOR_WHITE.b, 255};
+    if (g_refreshFrame)
+        std::snprintf(g_scoreText, sizeof(g_scoreText), "Score: %d", score);
+    HudRenderText(renderer, 10, 10, g_scoreText);
+}
 
-    SDL_Surface* surface = TTF_RenderText_Blended(g_hudFont, text.c_str(), color);
-    if (!surface)
-        return;
+void HudSetRefreshInterval(int frames)
+{
+    g_refreshInterval = frames > 1 ? frames : 1;
+    g_frameCounter = 0;
+}
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_Rect dst{10, 10, surface->w, surface->h};
-    SDL_FreeSurface(surface);
+bool HudIsRefreshFrame()
+{
+    return g_refreshFrame;
+}
 
-    if (!texture)
+void HudRenderText(SDL_Renderer* renderer, int x, int y, const char* text)
+{
+    if (!renderer || !text || !text[0] || !EnsureFontTexture(renderer))
         return;
 
-    SDL_RenderCopy(renderer, texture, nullptr, &dst);
-    SDL_DestroyTexture(texture);
+    SDL_SetTextureColorMod(g_fontTexture, COLOR_WHITE.r, COLOR_WHITE.g, COLOR_WHITE.b);
+
+    // 逐字符从图集中拷贝字形（同一纹理的连续拷贝会被 SDL 合批）
+    const HudFontAtlas& atlas = GetHudFontAtlas();
+    int penX = x;
+    for (const char* p = text; *p; ++p)
+    {
+        int index = static_cast<unsigned char>(*p) - HUD_FONT_FIRST_CHAR;
+        if (index < 0 || index >= HUD_FONT_GLYPH_COUNT)
+            index = '?' - HUD_FONT_FIRST_CHAR;  // 图集外的字符显示为问号
+
+        const HudGlyph& g = atlas.glyphs[index];
+        if (g.w > 0)
+        {
+            SDL_Rect src{g.x, g.y, g.w, g.h};
+            SDL_Rect dst{penX + g.offsetX, y + g.offsetY, g.w, g.h};
+            SDL_RenderCopy(renderer, g_fontTexture, &src, &dst);
+        }
+        penX += g.advance;
+    }
 }
@@ -5,3 +5,12 @@ struct SDL_Renderer;
 void HudInit();
 void HudShutdown();
 void HudRender(SDL_Renderer* renderer, int score);
+
+// 设置 HUD 文字每隔多少帧刷新一次（1 = 每帧刷新），其余帧沿用上次格式化的文字
+void HudSetRefreshInterval(int frames);
+
+// 本帧是否需要重新格式化 HUD 文字（HudRender 每帧调用一次后有效）
+bool HudIsRefreshFrame();
+
+// 在屏幕 (x, y) 处绘制一行白色文字
+void HudRenderText(SDL_Renderer* renderer, int x, int y, const char* text);
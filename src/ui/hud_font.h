@@ -0,0 +1,33 @@
+#pragma once
+
+// ===== 构建时烘焙的 HUD 字体图集 =====
+// tools/hud_font_baker 在构建时用 SDL_ttf 把 resource/ 中的字体光栅化，
+// 生成的源文件直接编译进程序，运行时无需读取字体文件，也不依赖 SDL_ttf
+
+#define HUD_FONT_FIRST_CHAR 32    // 图集中的第一个字符（空格）
+#define HUD_FONT_GLYPH_COUNT 95   // 可打印 ASCII 字符数量（32 ~ 126）
+
+// 单个字形在图集中的位置与排版信息
+struct HudGlyph
+{
+    short x;        // 图集中的左上角 x
+    short y;        // 图集中的左上角 y
+    short w;        // 字形宽度（像素）
+    short h;        // 字形高度（像素）
+    short offsetX;  // 绘制时相对笔位置的 x 偏移
+    short offsetY;  // 绘制时相对行顶部的 y 偏移
+    short advance;  // 绘制后笔位置前进的距离
+};
+
+// 字体图集
+struct HudFontAtlas
+{
+    int width;                             // 图集宽度（像素）
+    int height;                            // 图集高度（像素）
+    int lineHeight;                        // 行高（像素）
+    const unsigned char* pixels;           // 4 位灰度（透明度），每字节两个像素，低 4 位在前
+    HudGlyph glyphs[HUD_FONT_GLYPH_COUNT]; // 按字符编码排列的字形
+};
+
+// 获取烘焙进程序的字体图集（定义在构建时生成的 hud_font_atlas.cpp 中）
+const HudFontAtlas& GetHudFontAtlas();
@@ -0,0 +1,166 @@
+#include "alloc_tracker.h"
+
+#include <SDL.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // 本帧计数（音频等其他线程也可能分配，使用原子变量）
+    std::atomic<unsigned int> g_count[ALLOC_SCOPE_COUNT];
+    std::atomic<unsigned long long> g_bytes[ALLOC_SCOPE_COUNT];
+    AllocFrameStats g_lastFrame = {};
+
+    // 当前作用域（每个线程独立，默认 OTHER）
+    thread_local AllocScope t_scope = ALLOC_SCOPE_OTHER;
+
+#ifdef AIRCOMBAT_TRACK_ALLOCATIONS
+    void Record(size_t size)
+    {
+        g_count[t_scope].fetch_add(1, std::memory_order_relaxed);
+        g_bytes[t_scope].fetch_add(size, std::memory_order_relaxed);
+    }
+
+    // SDL 原始的内存函数
+    SDL_malloc_func g_sdlMalloc = nullptr;
+    SDL_calloc_func g_sdlCalloc = nullptr;
+    SDL_realloc_func g_sdlRealloc = nullptr;
+    SDL_free_func g_sdlFree = nullptr;
+
+    void* SDLCALL TrackedMalloc(size_t size)
+    {
+        Record(size);
+        return g_sdlMalloc(size);
+    }
+
+    void* SDLCALL TrackedCalloc(size_t count, size_t size)
+    {
+        Record(count * size);
+        return g_sdlCalloc(count, size);
+    }
+
+    // realloc 可能搬移内存，同样计为一次分配
+    void* SDLCALL TrackedRealloc(void* memory, size_t size)
+    {
+        Record(size);
+        return g_sdlRealloc(memory, size);
+    }
+
+    void SDLCALL TrackedFree(void* memory)
+    {
+        g_sdlFree(memory);
+    }
+#endif
+}
+
+AllocScopeGuard::AllocScopeGuard(AllocScope scope)
+    : previous(t_scope)
+{
+    t_scope = scope;
+}
+
+AllocScopeGuard::~AllocScopeGuard()
+{
+    t_scope = previous;
+}
+
+bool AllocTrackerIsEnabled()
+{
+#ifdef AIRCOMBAT_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocTrackerInstall()
+{
+#ifdef AIRCOMBAT_TRACK_ALLOCATIONS
+    if (g_sdlMalloc)
+        return;
+    SDL_GetMemoryFunctions(&g_sdlMalloc, &g_sdlCalloc, &g_sdlRealloc, &g_sdlFree);
+    if (SDL_SetMemoryFunctions(TrackedMalloc, TrackedCalloc, TrackedRealloc, TrackedFree) != 0)
+        SDL_Log("AllocTrackerInstall: SDL_SetMemoryFunctions failed - %s", SDL_GetError());
+#endif
+}
+
+void AllocTrackerEndFrame()
+{
+    g_lastFrame.totalCount = 0;
+    g_lastFrame.totalBytes = 0;
+    for (int i = 0; i < ALLOC_SCOPE_COUNT; ++i)
+    {
+        g_lastFrame.count[i] = g_count[i].exchange(0, std::memory_order_relaxed);
+        g_lastFrame.bytes[i] = g_bytes[i].exchange(0, std::memory_order_relaxed);
+        g_lastFrame.totalCount += g_lastFrame.count[i];
+        g_lastFrame.totalBytes += g_lastFrame.bytes[i];
+    }
+}
+
+const AllocFrameStats& GetAllocLastFrame()
+{
+    return g_lastFrame;
+}
+
+const char* GetAllocScopeName(AllocScope scope)
+{
+    switch (scope)
+    {
+    case ALLOC_SCOPE_OTHER: return "other";
+    case ALLOC_SCOPE_UPDATE: return "update";
+    case ALLOC_SCOPE_COLLISION: return "collision";
+    case ALLOC_SCOPE_RENDER: return "render";
+    case ALLOC_SCOPE_HUD: return "hud";
+    default: return "?";
+    }
+}
+
+void AllocTrackerFormatStats(char* buffer, int size)
+{
+    const AllocFrameStats& s = g_lastFrame;
+    std::snprintf(buffer, size, "Alloc/frame %u (%llu B)  upd %u  col %u  ren %u  hud %u  other %u",
+                  s.totalCount, s.totalBytes, s.count[ALLOC_SCOPE_UPDATE], s.count[ALLOC_SCOPE_COLLISION],
+                  s.count[ALLOC_SCOPE_RENDER], s.count[ALLOC_SCOPE_HUD], s.count[ALLOC_SCOPE_OTHER]);
+}
+
+// ===== 全局 operator new / delete =====
+// 只替换基本形式：数组与 nothrow 形式的默认实现会转调这里
+#ifdef AIRCOMBAT_TRACK_ALLOCATIONS
+void* operator new(std::size_t size)
+{
+    Record(size);
+    if (size == 0)
+        size = 1;
+    if (void* memory = std::malloc(size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+#endif
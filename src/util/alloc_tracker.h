@@ -0,0 +1,58 @@
+#pragma once
+
+// ===== 堆分配统计 =====
+// 以 AIRCOMBAT_TRACK_ALLOCATIONS 编译时替换全局 operator new 并接管 SDL 的内存函数，
+// 按"当前所处的子系统作用域"统计每帧的分配次数和字节数；
+// 未开启时作用域宏展开为空，统计函数返回 0，没有任何运行时开销
+
+// 子系统作用域
+enum AllocScope
+{
+    ALLOC_SCOPE_OTHER = 0,   // 不属于下列任何作用域（输入、联机、初始化等）
+    ALLOC_SCOPE_UPDATE,      // 实体更新
+    ALLOC_SCOPE_COLLISION,   // 碰撞检测
+    ALLOC_SCOPE_RENDER,      // 游戏对象渲染
+    ALLOC_SCOPE_HUD,         // HUD 文字
+    ALLOC_SCOPE_COUNT
+};
+
+// 一帧内各作用域的分配统计
+struct AllocFrameStats
+{
+    unsigned int count[ALLOC_SCOPE_COUNT];          // 分配次数
+    unsigned long long bytes[ALLOC_SCOPE_COUNT];    // 请求的字节数
+    unsigned int totalCount;
+    unsigned long long totalBytes;
+};
+
+// 进入作用域时切换当前作用域，离开时恢复（可嵌套）
+struct AllocScopeGuard
+{
+    AllocScope previous;
+    explicit AllocScopeGuard(AllocScope scope);
+    ~AllocScopeGuard();
+};
+
+#ifdef AIRCOMBAT_TRACK_ALLOCATIONS
+#define ALLOC_SCOPE(scope) AllocScopeGuard allocScopeGuard(scope)
+#else
+#define ALLOC_SCOPE(scope) ((void)0)
+#endif
+
+// 是否编译了分配统计
+bool AllocTrackerIsEnabled();
+
+// 接管 SDL 的内存函数（必须在 SDL_Init 之前调用，未开启统计时什么也不做）
+void AllocTrackerInstall();
+
+// 结束一帧：保存本帧统计并清零计数
+void AllocTrackerEndFrame();
+
+// 上一帧的统计
+const AllocFrameStats& GetAllocLastFrame();
+
+// 作用域名称（用于日志和 HUD）
+const char* GetAllocScopeName(AllocScope scope);
+
+// 把上一帧的统计格式化为一行文字（供 HUD 显示）
+void AllocTrackerFormatStats(char* buffer, int size);
@@ -19,23 +19,145 @@
 #define BULLET_RADIUS 5         // 子弹半径
 
 // ===== 玩家参数 =====
+#define MAX_PLAYERS 2           // 最多同时存在的玩家数量（联机时为 2）
 #define PLAYER_INITIAL_HEALTH 3  // 初始生命值
 #define PLAYER_SPEED 600.0      // 移动速度（像素/秒）
 #define PLAYER_BULLET_COOLDOWN 0.1  // 射击冷却时间（秒），值越小射速越快
 
+// ===== 输入参数 =====
+#define INPUT_EVENT_CAPACITY 64   // 每帧最多保留的带时间戳按键事件（超出时丢弃最早的）
+#define INPUT_MAX_SEGMENTS 16     // 每帧输入时间线的最大段数
+
 // ===== 子弹参数 =====
 #define BULLET_SPEED 800.0      // 子弹移动速度（像素/秒）
 #define BULLET_DAMAGE 1         // 每颗子弹伤害
+#define COLLISION_MASK_ALPHA 128  // 透明度不低于该值的精灵像素参与碰撞
+#define BULLET_MAX_LIFETIME 20.0  // 子弹最长存在时间（秒），永远不离开屏幕的弹道到时也会消失
+#define BULLET_CAPACITY 16384     // 子弹数组的预留容量，低于它时游戏过程中不再分配（场景 pattern_storm 峰值约 8500）
 
 // ===== 敌人参数 =====
-#define ENEMY_SPEED 200.0       // 敌机下落速度（像素/秒）
+#define ENEMY_SPEED 200.0       // 基础型敌机的速度（像素/秒），其他类型的参数见 enemy.cpp 中的特性表
 #define ENEMY_SPAWN_INTERVAL 1.0  // 敌机生成间隔（秒），值越小敌人越多
-#define ENEMY_HEALTH 1          // 敌机生命值
-#define ENEMY_SCORE (ENEMY_HEALTH * 10)          // 击杀敌机获得的分数
+#define ENEMY_HEALTH 1          // 基础型敌机的生命值
+#define ENEMY_CAPACITY 512      // 同时存在的敌机的预留容量，每种类型的数组都预留这么多（场景 heavy_spawn 峰值约 290）
+#define ENEMY_SCORE (ENEMY_HEALTH * 10)          // 击杀基础型敌机获得的分数
+#define ENEMY_MIN_DESCENT 0.35  // 追踪时方向的最小向下分量（敌机不会掉头向上飞）
+#define ENEMY_SEPARATION_RADIUS 70.0  // 敌机之间开始互相避让的距离（像素）
+#define ENEMY_SEPARATION_WEIGHT 1.5   // 避让力相对追踪方向的权重
+#define ENEMY_SEPARATION_NEIGHBORS 8  // 每个敌机最多考虑的邻居数量（保证单个敌机开销恒定）
+#define ENEMY_BULLET_SPEED 300.0      // 射手的子弹速度（像素/秒）
+#define ENEMY_BULLET_DAMAGE 1         // 敌机子弹命中玩家时扣除的生命
+#define ENEMY_BULLET_OWNER (-1)       // 敌机子弹的 owner（不属于任何玩家，只与玩家碰撞）
+
+// ===== Boss 参数 =====
+#define BOSS_SPAWN_INTERVAL 40.0    // 场上没有 Boss 时每隔多少秒出现一个
+#define BOSS_MAX_COUNT 2            // 同时存在的 Boss 上限
+#define BOSS_MAX_PARTS 64           // 每个 Boss 的部件上限（联机时用 64 位掩码同步存活部件）
+#define BOSS_BVH_LEAF_PARTS 4       // 包围盒层次中每个叶子最多包含的部件数
+#define BOSS_CELL_WIDTH 40          // 部件网格的格子尺寸（像素），Boss 由 9×5 个格子组成
+#define BOSS_CELL_HEIGHT 32
+#define BOSS_DESCENT_SPEED 60.0     // 入场下降速度（像素/秒）
+#define BOSS_HOVER_Y 40.0           // 入场后停留的高度
+#define BOSS_SWAY_AMPLITUDE 250.0   // 停留时左右摆动的幅度（像素）
+#define BOSS_SWAY_PERIOD 8.0        // 摆动周期（秒）
+#define BOSS_CORE_HEALTH 40         // 核心：被摧毁时整个 Boss 被消灭
+#define BOSS_CORE_SCORE 500
+#define BOSS_TURRET_HEALTH 8        // 炮塔
+#define BOSS_TURRET_SCORE 50
+#define BOSS_ARMOR_HEALTH 3         // 装甲板
+#define BOSS_ARMOR_SCORE 20
+
+// ===== 导弹与辅助瞄准 =====
+#define MISSILE_COOLDOWN 0.8        // 按住射击键时每隔多少秒发射一枚追踪导弹
+#define MISSILE_SPEED 450.0         // 导弹速度（像素/秒）
+#define MISSILE_TURN_RATE 4.0       // 导弹最大转向角速度（弧度/秒）
+#define MISSILE_DAMAGE 3            // 导弹伤害
+#define MISSILE_LIFETIME 4.0        // 导弹最长飞行时间（秒）
+#define AUTO_AIM_RANGE 500.0        // 辅助瞄准的最远距离（像素）
+#define AUTO_AIM_MAX_ANGLE 0.2      // 辅助瞄准最多把子弹偏离竖直方向多少弧度（0 = 关闭）
+#define AUTO_AIM_CANDIDATES 4       // 辅助瞄准检查的最近目标数量
+
+// ===== 空间索引 =====
+#define SPATIAL_CELL_SIZE 80        // 目标索引的网格边长（像素）
+#define SPATIAL_LINEAR_SCAN_MAX 64  // 目标不超过该数量时最近邻查询直接扫描全部目标
+
+// ===== 流场参数 =====
+#define FLOW_CELL_SIZE 40       // 流场网格边长（像素）
+
+// ===== 粒子参数 =====
+#define PARTICLE_CAPACITY 262144        // 粒子环形缓冲区容量（2 的幂）
+#define PARTICLE_BUDGET 200000          // 默认活跃粒子上限，超出时丢弃最早的粒子
+#define PARTICLE_RENDER_BUDGET 65536    // 每帧最多绘制的粒子数（优先绘制最新的）
+#define PARTICLE_SIZE 3.0               // 粒子边长（像素）
+#define PARTICLE_GRAVITY 300.0          // 粒子下坠加速度（像素/秒²）
+#define EXPLOSION_PARTICLES 64          // 一次爆炸生成的粒子数
+#define HIT_SPARK_PARTICLES 8           // 一次命中生成的火花数
+
+// ===== 关卡流式加载（--level）=====
+#define LEVEL_CHUNK_HEIGHT 512          // 每个数据块覆盖的卷轴距离（像素）
+#define LEVEL_CHUNK_BYTES 4096          // 文件中每个数据块的固定字节数（页大小的整数倍，解码后可以按块归还页面）
+#define LEVEL_CHUNK_MAX_SPAWNS 64       // 每块最多的出现点
+#define LEVEL_CHUNK_MAX_OBSTACLES 16    // 每块最多的障碍
+#define LEVEL_CHUNK_SLOTS 8             // 常驻内存的数据块数量
+#define LEVEL_LOOKAHEAD_CHUNKS 2        // 在屏幕顶端之外提前加载的块数
+#define LEVEL_SCROLL_SPEED 60.0         // 默认卷轴速度（像素/秒）
+
+// ===== 视差背景 =====
+#define BACKGROUND_LAYERS 4         // 背景层数（三层星空 + 一层云）
 
 // ===== 帧率配置 =====
 #define TARGET_FPS 60           // 目标帧率
 #define TIMER_INTERVAL (1000 / TARGET_FPS)  // 单帧耗时（毫秒）
+#define PACER_SPIN_MS 2.0       // 低延迟模式下帧末自旋等待的时长（毫秒），用于补偿睡眠精度
+#define LATENCY_WINDOW 120      // 输入延迟统计的样本数
+#define FIRST_FRAME_TARGET_MS 50  // 启动到第一帧提交的目标耗时（毫秒）
+
+// ===== 音频 =====
+#define AUDIO_FREQUENCY 48000       // 请求的采样率（音效按设备实际采样率合成）
+#define AUDIO_BUFFER_SAMPLES 512    // 每次回调的采样帧数
+#define AUDIO_MAX_VOICES 32         // 同时发声的音效上限，超出时抢占最早开始的
+#define AUDIO_COMMAND_CAPACITY 256  // 游戏线程到混音线程的命令队列容量（2 的幂）
+#define AUDIO_MASTER_VOLUME 0.8f    // 总音量
+
+// ===== 分配检查（--alloc-check）=====
+#define ALLOC_CHECK_WARMUP_FRAMES 300   // 预热帧数，之后的每一帧都不允许堆分配
+#define ALLOC_CHECK_FRAMES 1800         // 默认检查的总帧数
+
+// ===== 遥测（--telemetry）=====
+#define TELEMETRY_CHUNK_ROWS 1024   // 每个列式数据块的行数（tick 数）
+#define TELEMETRY_CHUNK_POOL 4      // 数据块数量，后台线程落后这么多块时开始丢弃
+
+// ===== 二进制日志（--log）=====
+#define LOG_RING_RECORDS 4096       // 每个线程环形缓冲的记录数（2 的幂）
+#define LOG_MAX_THREADS 8           // 最多记录日志的线程数
+#define LOG_MAX_ARGS 4              // 每条记录最多的参数个数
+#define LOG_DRAIN_INTERVAL_MS 10    // 后台线程写出的间隔
+
+// ===== 游戏事件 =====
+#define GAME_EVENT_MAX_HANDLERS 8   // 每类事件最多的订阅数
+#define GAME_EVENT_RESERVE 1024     // 事件数组的初始容量
+
+// ===== 帧时间预算调节 =====
+#define GOVERNOR_WINDOW 30          // 每次决策统计的帧数
+#define GOVERNOR_HIGH_RATIO 0.9     // 平均工作时间超过预算的该比例时降一级
+#define GOVERNOR_LOW_RATIO 0.5      // 平均工作时间低于预算的该比例时视为有余量
+#define GOVERNOR_RECOVER_WINDOWS 4  // 连续多少个窗口有余量才升一级（防止来回抖动）
+#define GOVERNOR_PARTICLE_BUDGET (PARTICLE_BUDGET / 4)  // 降级后的粒子上限
+#define GOVERNOR_BACKGROUND_LAYERS 2    // 降级后保留的背景层数（去掉最近的几层）
+#define GOVERNOR_CIRCLE_STEP 4      // 降级后圆形按多少像素一条扫描带绘制
+#define GOVERNOR_HUD_INTERVAL 10    // 降级后 HUD 文字每隔多少帧刷新一次
+#define GOVERNOR_MAX_ENEMIES 40     // 降级后同时存在的敌机上限
+#define GOVERNOR_MAX_BULLETS 200    // 降级后同时存在的子弹上限
+
+// ===== 联机配置 =====
+#define NET_DEFAULT_PORT 27015      // 默认 UDP 端口
+#define NET_MAX_PACKET 16384        // 单个 UDP 包的最大字节数（本机回环无需考虑 MTU）
+#define NET_MAX_ENEMIES 256         // 快照中最多同步的敌人数量
+#define NET_MAX_BULLETS 1024        // 快照中最多同步的子弹数量
+#define NET_MAX_BOSSES BOSS_MAX_COUNT  // 快照中最多同步的 Boss 数量
+#define NET_POSITION_SCALE 4.0      // 坐标量化精度（1/4 像素）
+#define NET_INTERP_DELAY_MS 100     // 客户端插值延迟（毫秒），需大于快照间隔
+#define NET_TIMEOUT_MS 3000         // 超过该时间未收到对方数据视为断开
 
 // ===== 颜色常量 =====
 constexpr Color COLOR_WHITE{255, 255, 255};  // 白色
@@ -43,3 +165,4 @@ constexpr Color COLOR_BLACK{0, 0, 0};        // 黑色
 constexpr Color COLOR_RED{255, 0, 0};        // 红色（子弹）
 constexpr Color COLOR_BLUE{0, 0, 255};       // 蓝色（玩家）
 constexpr Color COLOR_GREEN{0, 255, 0};      // 绿色
+constexpr Color COLOR_YELLOW{255, 220, 0};   // 黄色（敌机子弹）
@@ -0,0 +1,299 @@
+#include "log.h"
+
+#include "config.h"
+
+#include <SDL.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    const unsigned int kVersion = 1;
+
+    struct LogFormat
+    {
+        const char* name;
+        int argCount;
+        const char* format;
+    };
+
+    const LogFormat kFormats[LOG_MESSAGE_COUNT] = {
+        {"tick", 1, "tick at %.3f ms"},
+        {"dropped", 2, "%d records dropped on thread %d"},
+        {"enemy_spawn", 3, "enemy %d spawned at (%.0f, %.0f)"},
+        {"bullet_hit", 4, "player %d hit target kind %d at (%.0f, %.0f)"},
+        {"kill", 4, "player %d destroyed target kind %d at (%.0f, %.0f)"},
+        {"player_damaged", 3, "player %d crashed into target kind %d, health -%d"},
+        {"frame_overrun", 2, "frame work %.2f ms over the %.2f ms budget"},
+        {"governor_level", 2, "governor level %d -> %d"},
+        {"level_late", 2, "level chunk %d not ready at distance %.0f"},
+        {"player_shot", 4, "player %d shot by an enemy at (%.0f, %.0f), health -%d"},
+    };
+    static_assert((LOG_RING_RECORDS & (LOG_RING_RECORDS - 1)) == 0, "Ring size must be a power of two");
+    static_assert(LOG_MAX_ARGS == 4, "LogWrite takes four arguments");
+
+    struct LogRecord
+    {
+        uint32_t tick;
+        uint16_t message;
+        double args[LOG_MAX_ARGS];
+    };
+
+    // 单生产者（领取它的线程）单消费者（后台线程）环形缓冲；头尾计数放在不同的缓存行，互不干扰
+    struct LogRing
+    {
+        alignas(64) std::atomic<uint32_t> head;     // 生产者写入
+        std::atomic<uint32_t> dropped;              // 生产者写入：写满时丢弃的记录数
+        alignas(64) std::atomic<uint32_t> tail;     // 后台线程写入
+        uint32_t reportedDrops;                     // 只在后台线程访问：已写成 LOG_DROPPED 的丢弃数
+        LogRecord records[LOG_RING_RECORDS];
+    };
+
+    // 线程第一次记录时按顺序领取环形缓冲；领取关系在关闭后保留，重新打开时只清空内容
+    LogRing g_rings[LOG_MAX_THREADS];
+    std::atomic<int> g_ringCount{0};
+    std::atomic<long long> g_unclaimedDrops{0};  // 超出 LOG_MAX_THREADS 的线程的记录
+    thread_local int t_ring = -1;                // 本线程的环形缓冲（-1 未领取，-2 已用完）
+
+    std::atomic<bool> g_open{false};
+    std::atomic<bool> g_stopping{false};
+    std::atomic<uint32_t> g_tick{0};
+    std::atomic<long long> g_written{0};
+
+    SDL_Thread* g_drainer = nullptr;
+    SDL_sem* g_wake = nullptr;      // 关闭时唤醒后台线程做最后一次写出
+    FILE* g_file = nullptr;
+    Uint64 g_openCounter = 0;
+    double g_frequency = 1.0;
+
+    // 以下只在后台线程访问（一条记录最多 8 + 8 * LOG_MAX_ARGS 字节；
+    // 环满时一次写出 LOG_RING_RECORDS 条记录外加一条 LOG_DROPPED）
+    uint8_t g_encoded[(LOG_RING_RECORDS + 1) * (8 + 8 * LOG_MAX_ARGS)];
+
+    void WriteU32(FILE* file, uint32_t value)
+    {
+        uint8_t bytes[4] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+                            static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)};
+        std::fwrite(bytes, 1, 4, file);
+    }
+
+    size_t PutU16(uint8_t* out, uint32_t value)
+    {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+        return 2;
+    }
+
+    size_t PutU32(uint8_t* out, uint32_t value)
+    {
+        PutU16(out, value);
+        PutU16(out + 2, value >> 16);
+        return 4;
+    }
+
+    size_t PutF64(uint8_t* out, double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        PutU32(out, static_cast<uint32_t>(bits));
+        PutU32(out + 4, static_cast<uint32_t>(bits >> 32));
+        return 8;
+    }
+
+    size_t EncodeRecord(const LogRecord& record, int thread, uint8_t* out)
+    {
+        int argCount = kFormats[record.message].argCount;
+        size_t size = PutU32(out, record.tick);
+        size += PutU16(out + size, record.message);
+        out[size++] = static_cast<uint8_t>(thread);
+        out[size++] = static_cast<uint8_t>(argCount);
+        for (int i = 0; i < argCount; ++i)
+            size += PutF64(out + size, record.args[i]);
+        return size;
+    }
+
+    // 写出一个环形缓冲中已提交的全部记录；有新的丢弃时追加一条 LOG_DROPPED
+    void DrainRing(int thread)
+    {
+        LogRing& ring = g_rings[thread];
+        uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+        uint32_t head = ring.head.load(std::memory_order_acquire);
+        size_t size = 0;
+        for (uint32_t i = tail; i != head; ++i)
+            size += EncodeRecord(ring.records[i & (LOG_RING_RECORDS - 1)], thread, g_encoded + size);
+        ring.tail.store(head, std::memory_order_release);
+
+        uint32_t dropped = ring.dropped.load(std::memory_order_relaxed);
+        long long records = static_cast<long long>(head - tail);
+        if (dropped != ring.reportedDrops)
+        {
+            LogRecord record = {g_tick.load(std::memory_order_relaxed), LOG_DROPPED,
+                                {static_cast<double>(dropped - ring.reportedDrops), static_cast<double>(thread)}};
+            size += EncodeRecord(record, thread, g_encoded + size);
+            ring.reportedDrops = dropped;
+            records++;
+        }
+        if (size > 0)
+            std::fwrite(g_encoded, 1, size, g_file);
+        g_written.fetch_add(records, std::memory_order_relaxed);
+    }
+
+    // 后台线程：每隔 LOG_DRAIN_INTERVAL_MS 写出所有环形缓冲，收到停止请求后再写一遍然后退出
+    int DrainThread(void*)
+    {
+        for (;;)
+        {
+            bool stopping = g_stopping.load(std::memory_order_acquire);
+            int rings = g_ringCount.load(std::memory_order_acquire);
+            for (int thread = 0; thread < rings && thread < LOG_MAX_THREADS; ++thread)
+                DrainRing(thread);
+            if (stopping)
+                return 0;
+            SDL_SemWaitTimeout(g_wake, LOG_DRAIN_INTERVAL_MS);
+        }
+    }
+
+    LogRing* ThreadRing()
+    {
+        if (t_ring == -1)
+        {
+            int index = g_ringCount.fetch_add(1, std::memory_order_acq_rel);
+            t_ring = index < LOG_MAX_THREADS ? index : -2;
+        }
+        return t_ring >= 0 ? &g_rings[t_ring] : nullptr;
+    }
+}
+
+bool LogOpen(const char* path)
+{
+    if (g_open.load())
+        LogClose();
+
+    g_file = std::fopen(path, "wb");
+    if (!g_file)
+    {
+        SDL_Log("LogOpen: cannot write %s", path);
+        return false;
+    }
+
+    // 文件头：格式串让读取工具不需要知道消息的定义
+    std::fwrite("ACLG", 1, 4, g_file);
+    WriteU32(g_file, kVersion);
+    WriteU32(g_file, LOG_MESSAGE_COUNT);
+    for (const LogFormat& format : kFormats)
+    {
+        uint8_t nameLength = static_cast<uint8_t>(std::strlen(format.name));
+        uint8_t argCount = static_cast<uint8_t>(format.argCount);
+        uint8_t formatLength[2];
+        PutU16(formatLength, static_cast<uint32_t>(std::strlen(format.format)));
+        std::fwrite(&nameLength, 1, 1, g_file);
+        std::fwrite(format.name, 1, nameLength, g_file);
+        std::fwrite(&argCount, 1, 1, g_file);
+        std::fwrite(formatLength, 1, 2, g_file);
+        std::fwrite(format.format, 1, std::strlen(format.format), g_file);
+    }
+
+    for (LogRing& ring : g_rings)
+    {
+        ring.head.store(0);
+        ring.tail.store(0);
+        ring.dropped.store(0);
+        ring.reportedDrops = 0;
+    }
+    g_unclaimedDrops.store(0);
+    g_tick.store(0);
+    g_written.store(0);
+    g_stopping.store(false);
+    g_frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    g_openCounter = SDL_GetPerformanceCounter();
+
+    g_wake = SDL_CreateSemaphore(0);
+    g_drainer = g_wake ? SDL_CreateThread(DrainThread, "log", nullptr) : nullptr;
+    if (!g_drainer)
+    {
+        SDL_Log("LogOpen: cannot start writer thread - %s", SDL_GetError());
+        if (g_wake)
+            SDL_DestroySemaphore(g_wake);
+        g_wake = nullptr;
+        std::fclose(g_file);
+        g_file = nullptr;
+        return false;
+    }
+    g_open.store(true, std::memory_order_release);
+    return true;
+}
+
+void LogClose()
+{
+    if (!g_open.load())
+        return;
+
+    g_open.store(false, std::memory_order_release);
+    g_stopping.store(true, std::memory_order_release);
+    SDL_SemPost(g_wake);
+    SDL_WaitThread(g_drainer, nullptr);
+    SDL_DestroySemaphore(g_wake);
+    std::fclose(g_file);
+    g_drainer = nullptr;
+    g_wake = nullptr;
+    g_file = nullptr;
+
+    SDL_Log("Log: %lld records written, %lld dropped", GetLogWrittenCount(), GetLogDroppedCount());
+}
+
+bool LogIsOpen()
+{
+    return g_open.load(std::memory_order_relaxed);
+}
+
+void LogBeginTick()
+{
+    if (!g_open.load(std::memory_order_relaxed))
+        return;
+    g_tick.store(g_tick.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    LogWrite(LOG_TICK, static_cast<double>(SDL_GetPerformanceCounter() - g_openCounter) * 1000.0 / g_frequency);
+}
+
+void LogWrite(LogMessage message, double a, double b, double c, double d)
+{
+    if (!g_open.load(std::memory_order_relaxed))
+        return;
+    LogRing* ring = ThreadRing();
+    if (!ring)
+    {
+        g_unclaimedDrops.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // 写满时丢弃（只有本线程写 head 和 dropped，不需要原子的读改写）
+    uint32_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= LOG_RING_RECORDS)
+    {
+        ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    LogRecord& record = ring->records[head & (LOG_RING_RECORDS - 1)];
+    record.tick = g_tick.load(std::memory_order_relaxed);
+    record.message = static_cast<uint16_t>(message);
+    record.args[0] = a;
+    record.args[1] = b;
+    record.args[2] = c;
+    record.args[3] = d;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+long long GetLogWrittenCount()
+{
+    return g_written.load(std::memory_order_relaxed);
+}
+
+long long GetLogDroppedCount()
+{
+    long long dropped = g_unclaimedDrops.load(std::memory_order_relaxed);
+    for (const LogRing& ring : g_rings)
+        dropped += ring.dropped.load(std::memory_order_relaxed);
+    return dropped;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+// ===== 二进制结构化日志 =====
+// 热路径上只记录"消息编号 + 原始参数"，不格式化文字：每个线程第一次记录时领取一个单生产者环形缓冲，
+// 之后每条记录是一次无锁写入（不读时钟、不加锁、不分配内存）。后台线程每 LOG_DRAIN_INTERVAL_MS
+// 把各个环形缓冲中的记录写入二进制文件，离线工具 log_dump 按文件头中的格式串还原成文字。
+// 环形缓冲写满时丢弃新记录并计数，后台线程把丢弃数量作为一条 LOG_DROPPED 记录写进文件，不会阻塞记录方。
+// 时间以 tick 为单位：LogBeginTick 推进全局 tick 并记一条带时间戳的 LOG_TICK，其他记录只带 tick 编号
+//
+// 文件格式（小端）：
+//   文件头  "ACLG"  u32 版本  u32 消息数
+//           每条消息：u8 名称长度 + 名称  u8 参数个数  u16 格式串长度 + 格式串（printf 风格，只用 %d 和 %f 类转换）
+//   记录    u32 tick  u16 消息编号  u8 线程编号  u8 参数个数  每个参数 f64（整数参数按 %d 转换时取整）
+
+// 消息编号（文件中的顺序，只能在末尾追加）
+enum LogMessage
+{
+    LOG_TICK = 0,           // 新的 tick 开始（参数：距打开日志的毫秒数）
+    LOG_DROPPED,            // 环形缓冲写满丢弃的记录（由后台线程写入）
+    LOG_ENEMY_SPAWN,        // 敌机生成
+    LOG_BULLET_HIT,         // 子弹命中
+    LOG_KILL,               // 子弹击毁目标
+    LOG_PLAYER_DAMAGED,     // 玩家被撞
+    LOG_FRAME_OVERRUN,      // 一帧的工作时间超出预算
+    LOG_GOVERNOR_LEVEL,     // 负载等级变化
+    LOG_LEVEL_LATE,         // 关卡数据块没有按时就绪
+    LOG_PLAYER_SHOT,        // 玩家被敌机子弹击中
+    LOG_MESSAGE_COUNT
+};
+
+// 创建文件、写入文件头并启动后台线程，失败时返回 false（之后的记录被忽略）
+// 打开和关闭只在主线程调用，此时其他线程不应正在记录
+bool LogOpen(const char* path);
+
+// 写出所有剩余记录，停止后台线程并关闭文件
+void LogClose();
+
+// 是否正在记录
+bool LogIsOpen();
+
+// 推进 tick 编号并记录一条 LOG_TICK（每次 GameUpdate 开始时调用）
+void LogBeginTick();
+
+// 记录一条消息（任意线程；未打开时直接返回），参数个数以消息定义为准，多余的忽略
+void LogWrite(LogMessage message, double a = 0.0, double b = 0.0, double c = 0.0, double d = 0.0);
+
+// 统计信息
+long long GetLogWrittenCount();    // 已写入文件的记录数
+long long GetLogDroppedCount();    // 因环形缓冲写满而丢弃的记录数
@@ -0,0 +1,233 @@
+#include "telemetry.h"
+
+#include "config.h"
+
+#include <SDL.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    const unsigned int kVersion = 1;
+
+    const char* const kColumnNames[TELEMETRY_COLUMN_COUNT] = {
+        "tick", "dt_us", "update_us", "enemies", "bullets", "particles", "enemy_spawns", "shots",
+        "hits", "kills", "player_hits", "score_p1", "health_p1", "score_p2", "health_p2", "governor_level",
+    };
+
+    // 一个列式数据块：同一列的值连续存放，压缩时逐列做差分
+    struct TelemetryChunk
+    {
+        int rows;
+        int32_t columns[TELEMETRY_COLUMN_COUNT][TELEMETRY_CHUNK_ROWS];
+    };
+
+    // 块池按顺序循环使用：游戏线程填写第 g_produced 块，后台线程写出第 g_consumed 块。
+    // g_produced - g_consumed 是等待写出的块数，始终小于池大小，因此游戏线程手里总有一块
+    TelemetryChunk g_chunks[TELEMETRY_CHUNK_POOL];
+    std::atomic<unsigned int> g_produced{0};
+    std::atomic<unsigned int> g_consumed{0};
+    std::atomic<bool> g_stopping{false};
+
+    SDL_Thread* g_writer = nullptr;
+    SDL_sem* g_ready = nullptr;     // 每交出一块（或请求停止）发一次信号
+    FILE* g_file = nullptr;
+    bool g_open = false;
+
+    // 以下只在游戏线程访问
+    int g_recorded = 0;
+    int g_dropped = 0;
+
+    // 以下只在后台线程访问（最坏情况每个值 5 字节）
+    uint8_t g_encoded[TELEMETRY_CHUNK_ROWS * 5];
+
+    void WriteU32(FILE* file, uint32_t value)
+    {
+        uint8_t bytes[4] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+                            static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)};
+        std::fwrite(bytes, 1, 4, file);
+    }
+
+    // 一列：相邻值之差 zigzag 后按 LEB128 编码（计数类的列差值很小，大多只占 1 字节）
+    size_t EncodeColumn(const int32_t* values, int rows, uint8_t* out)
+    {
+        size_t size = 0;
+        int32_t previous = 0;
+        for (int i = 0; i < rows; ++i)
+        {
+            uint32_t delta = static_cast<uint32_t>(values[i]) - static_cast<uint32_t>(previous);
+            uint32_t zigzag = (delta << 1) ^ static_cast<uint32_t>(-static_cast<int32_t>(delta >> 31));
+            previous = values[i];
+            while (zigzag >= 0x80u)
+            {
+                out[size++] = static_cast<uint8_t>(zigzag | 0x80u);
+                zigzag >>= 7;
+            }
+            out[size++] = static_cast<uint8_t>(zigzag);
+        }
+        return size;
+    }
+
+    void WriteChunk(const TelemetryChunk& chunk)
+    {
+        WriteU32(g_file, static_cast<uint32_t>(chunk.rows));
+        for (int c = 0; c < TELEMETRY_COLUMN_COUNT; ++c)
+        {
+            size_t size = EncodeColumn(chunk.columns[c], chunk.rows, g_encoded);
+            WriteU32(g_file, static_cast<uint32_t>(size));
+            std::fwrite(g_encoded, 1, size, g_file);
+        }
+    }
+
+    // 后台线程：把交出的块依次压缩写盘，收到停止请求且没有剩余块时退出
+    int WriterThread(void*)
+    {
+        for (;;)
+        {
+            SDL_SemWait(g_ready);
+            unsigned int consumed = g_consumed.load(std::memory_order_relaxed);
+            while (consumed != g_produced.load(std::memory_order_acquire))
+            {
+                WriteChunk(g_chunks[consumed % TELEMETRY_CHUNK_POOL]);
+                g_consumed.store(++consumed, std::memory_order_release);
+            }
+            if (g_stopping.load(std::memory_order_acquire))
+                return 0;
+        }
+    }
+
+    // 交出当前块；等待写出的块已占满其余的池时丢弃它，游戏线程继续复用这一块
+    void SubmitChunk()
+    {
+        unsigned int produced = g_produced.load(std::memory_order_relaxed);
+        TelemetryChunk& chunk = g_chunks[produced % TELEMETRY_CHUNK_POOL];
+        if (chunk.rows == 0)
+            return;
+        if (produced + 1 - g_consumed.load(std::memory_order_acquire) >= TELEMETRY_CHUNK_POOL)
+        {
+            g_dropped += chunk.rows;
+            chunk.rows = 0;
+            return;
+        }
+        g_produced.store(produced + 1, std::memory_order_release);
+        g_chunks[(produced + 1) % TELEMETRY_CHUNK_POOL].rows = 0;
+        SDL_SemPost(g_ready);
+    }
+}
+
+bool TelemetryOpen(const char* path)
+{
+    if (g_open)
+        TelemetryClose();
+
+    g_file = std::fopen(path, "wb");
+    if (!g_file)
+    {
+        SDL_Log("TelemetryOpen: cannot write %s", path);
+        return false;
+    }
+
+    // 文件头：列名让读取工具不需要知道列的定义
+    std::fwrite("ACTL", 1, 4, g_file);
+    WriteU32(g_file, kVersion);
+    WriteU32(g_file, TELEMETRY_COLUMN_COUNT);
+    for (const char* name : kColumnNames)
+    {
+        uint8_t length = static_cast<uint8_t>(std::strlen(name));
+        std::fwrite(&length, 1, 1, g_file);
+        std::fwrite(name, 1, length, g_file);
+    }
+
+    g_produced.store(0);
+    g_consumed.store(0);
+    g_stopping.store(false);
+    g_chunks[0].rows = 0;
+    g_recorded = 0;
+    g_dropped = 0;
+
+    g_ready = SDL_CreateSemaphore(0);
+    g_writer = g_ready ? SDL_CreateThread(WriterThread, "telemetry", nullptr) : nullptr;
+    if (!g_writer)
+    {
+        SDL_Log("TelemetryOpen: cannot start writer thread - %s", SDL_GetError());
+        if (g_ready)
+            SDL_DestroySemaphore(g_ready);
+        g_ready = nullptr;
+        std::fclose(g_file);
+        g_file = nullptr;
+        return false;
+    }
+    g_open = true;
+    return true;
+}
+
+void TelemetryClose()
+{
+    if (!g_open)
+        return;
+
+    SubmitChunk();
+    g_stopping.store(true, std::memory_order_release);
+    SDL_SemPost(g_ready);
+    SDL_WaitThread(g_writer, nullptr);
+    SDL_DestroySemaphore(g_ready);
+    std::fclose(g_file);
+    g_writer = nullptr;
+    g_ready = nullptr;
+    g_file = nullptr;
+    g_open = false;
+
+    SDL_Log("Telemetry: %d ticks recorded, %d dropped", g_recorded, g_dropped);
+}
+
+bool TelemetryIsOpen()
+{
+    return g_open;
+}
+
+void TelemetryRecord(const TelemetryTick& tick)
+{
+    if (!g_open)
+        return;
+
+    TelemetryChunk& chunk = g_chunks[g_produced.load(std::memory_order_relaxed) % TELEMETRY_CHUNK_POOL];
+    int row = chunk.rows;
+    chunk.columns[TELEMETRY_TICK][row] = g_recorded++;
+    chunk.columns[TELEMETRY_DT_US][row] = tick.dtUs;
+    chunk.columns[TELEMETRY_UPDATE_US][row] = tick.updateUs;
+    chunk.columns[TELEMETRY_ENEMIES][row] = tick.enemies;
+    chunk.columns[TELEMETRY_BULLETS][row] = tick.bullets;
+    chunk.columns[TELEMETRY_PARTICLES][row] = tick.particles;
+    chunk.columns[TELEMETRY_ENEMY_SPAWNS][row] = tick.enemySpawns;
+    chunk.columns[TELEMETRY_SHOTS][row] = tick.shots;
+    chunk.columns[TELEMETRY_HITS][row] = tick.hits;
+    chunk.columns[TELEMETRY_KILLS][row] = tick.kills;
+    chunk.columns[TELEMETRY_PLAYER_HITS][row] = tick.playerHits;
+    chunk.columns[TELEMETRY_SCORE_P1][row] = tick.score[0];
+    chunk.columns[TELEMETRY_HEALTH_P1][row] = tick.health[0];
+    chunk.columns[TELEMETRY_SCORE_P2][row] = tick.score[1];
+    chunk.columns[TELEMETRY_HEALTH_P2][row] = tick.health[1];
+    chunk.columns[TELEMETRY_GOVERNOR_LEVEL][row] = tick.governorLevel;
+    chunk.rows = row + 1;
+
+    if (chunk.rows == TELEMETRY_CHUNK_ROWS)
+        SubmitChunk();
+}
+
+const char* GetTelemetryColumnName(TelemetryColumn column)
+{
+    return column >= 0 && column < TELEMETRY_COLUMN_COUNT ? kColumnNames[column] : "?";
+}
+
+int GetTelemetryRecordedTicks()
+{
+    return g_recorded;
+}
+
+int GetTelemetryDroppedTicks()
+{
+    return g_dropped;
+}
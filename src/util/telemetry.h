@@ -0,0 +1,70 @@
+#pragma once
+
+// ===== 逐 tick 遥测 =====
+// 每个 tick 的实体数量、生成、命中、得分、生命和耗时按列追加到固定大小的内存块中，
+// 写满的块交给后台线程压缩后写入文件；游戏线程每个 tick 只做十几次存储，不加锁、不分配内存。
+// 后台线程落后太多（没有空闲块）时丢弃当前块并计数，不会阻塞游戏线程。
+//
+// 文件格式（小端）：
+//   文件头  "ACTL"  u32 版本  u32 列数  每列：u8 名称长度 + 名称
+//   数据块  u32 行数  每列：u32 字节数 + 数据（相邻行之差做 zigzag 后按 LEB128 变长编码，块内第一行与 0 相减）
+// 读取工具 telemetry_dump 只依赖文件头中的列名，增加列不需要改工具
+
+// 列（文件中的顺序）
+enum TelemetryColumn
+{
+    TELEMETRY_TICK = 0,         // 打开遥测后的 tick 序号
+    TELEMETRY_DT_US,            // 本 tick 的时间步长（微秒）
+    TELEMETRY_UPDATE_US,        // GameUpdate 耗时（微秒）
+    TELEMETRY_ENEMIES,          // 更新后的敌机数量
+    TELEMETRY_BULLETS,          // 更新后的子弹数量
+    TELEMETRY_PARTICLES,        // 更新后的粒子数量
+    TELEMETRY_ENEMY_SPAWNS,     // 本 tick 生成的敌机
+    TELEMETRY_SHOTS,            // 本 tick 发射的子弹
+    TELEMETRY_HITS,             // 子弹命中次数
+    TELEMETRY_KILLS,            // 击毁敌机数
+    TELEMETRY_PLAYER_HITS,      // 玩家被撞次数
+    TELEMETRY_SCORE_P1,
+    TELEMETRY_HEALTH_P1,
+    TELEMETRY_SCORE_P2,         // 单人时为 0
+    TELEMETRY_HEALTH_P2,
+    TELEMETRY_GOVERNOR_LEVEL,   // 帧时间预算调节的等级
+    TELEMETRY_COLUMN_COUNT
+};
+
+// 一个 tick 的数据（tick 序号由遥测模块自己维护）
+struct TelemetryTick
+{
+    int dtUs;
+    int updateUs;
+    int enemies;
+    int bullets;
+    int particles;
+    int enemySpawns;
+    int shots;
+    int hits;
+    int kills;
+    int playerHits;
+    int score[2];
+    int health[2];
+    int governorLevel;
+};
+
+// 创建文件、写入文件头并启动后台写入线程，失败时返回 false（之后的记录被忽略）
+bool TelemetryOpen(const char* path);
+
+// 提交未写满的块，等待后台线程写完并关闭文件
+void TelemetryClose();
+
+// 是否正在记录
+bool TelemetryIsOpen();
+
+// 追加一行（只在游戏线程调用，未打开时直接返回）
+void TelemetryRecord(const TelemetryTick& tick);
+
+// 列名（即文件头中的名称）
+const char* GetTelemetryColumnName(TelemetryColumn column);
+
+// 统计信息
+int GetTelemetryRecordedTicks();   // 已记录的行数
+int GetTelemetryDroppedTicks();    // 因后台线程来不及写入而丢弃的行数
@@ -41,3 +41,11 @@ struct Color
     unsigned char g;  // 绿色分量 0-255
     unsigned char b;  // 蓝色分量 0-255
 };
+
+// 一帧内的一段输入：从 start 开始到下一段开始期间保持 bits 不变
+// start 是该段在本帧时间窗口中的位置（0 = 帧开始，1 = 帧结束）
+struct InputSegment
+{
+    double start;       // 段起点（帧内比例 0~1）
+    unsigned int bits;  // 该段的输入位掩码（InputBits 组合）
+};
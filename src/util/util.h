@@ -4,26 +4,56 @@
 
 #include <cmath>
 
+// 数学和碰撞函数都在头文件中内联定义：碰撞检测的内层循环每帧要调用 B×E 次，
+// 放在 util.cpp 里时每次都是一次跨编译单元的函数调用，无法内联
+
 // ===== 数学函数 =====
 // 计算向量的长度—勾股定理
-double Length(Vector2 v);
-
-// 将向量正规化为单位向量
-Vector2 Normalize(Vector2 v);
+inline double Length(Vector2 v)
+{
+    return std::sqrt(v.x * v.x + v.y * v.y);
+}
+
+// 将向量正规化为单位向量（方向不变，长度变为1）
+// 特殊情况：向量为0时返回 (0, 0)
+inline Vector2 Normalize(Vector2 v)
+{
+    double len = Length(v);
+    if (len <= 0.000001)  // 不为0以避免除以0错误
+        return {0.0, 0.0};
+    return {v.x / len, v.y / len};
+}
 
 // 两个向量的点积
-double Dot(Vector2 v1, Vector2 v2);
+constexpr double Dot(Vector2 v1, Vector2 v2)
+{
+    return v1.x * v2.x + v1.y * v2.y;
+}
 
 // 计算两个点之间的欧氏距离
-double Distance(Vector2 p1, Vector2 p2);
+inline double Distance(Vector2 p1, Vector2 p2)
+{
+    double dx = p2.x - p1.x;
+    double dy = p2.y - p1.y;
+    return std::sqrt(dx * dx + dy * dy);
+}
 
 // 限制值到指定范围（夹取）
-double Clamp(double value, double min, double max);
+constexpr double Clamp(double value, double min, double max)
+{
+    return value < min ? min : (value > max ? max : value);
+}
 
-// 线性插值
-double Lerp(double a, double b, double t);
+// 线性插值（于 a 和 b 之间按比例 t 作插值）
+constexpr double Lerp(double a, double b, double t)
+{
+    return a + (b - a) * t;
+}
 
 // ===== 随机数函数 =====
+// 使用固定种子（性能测试等需要可重复的随机序列时调用），否则首次使用时以当前时间为种子
+void SetRandomSeed(unsigned int seed);
+
 // 给定范围内的随机整数
 int GetRandomInt(int min, int max);
 
@@ -34,24 +64,52 @@ double GetRandomDouble(double min, double max);
 bool GetRandomBool();
 
 // ===== 碰撞检测函数 =====
-// 矩形与矩形碰撞检测
-bool IsRectRectCollision(Rect r1, Rect r2);
-
-// 矩形与圆形碰撞检测
-bool IsRectCircleCollision(Rect rect, Circle circle);
-
-// 圆形与圆形碰撞检测
-bool IsCircleCircleCollision(Circle c1, Circle c2);
+// 矩形与矩形碰撞检测（任一轴分离则无碰撞）
+constexpr bool IsRectRectCollision(Rect r1, Rect r2)
+{
+    return !(r1.right < r2.left || r1.left > r2.right) && !(r1.bottom < r2.top || r1.top > r2.bottom);
+}
+
+// 矩形与圆形碰撞检测：矩形上离圆心最近的点在圆内即碰撞
+constexpr bool IsRectCircleCollision(Rect rect, Circle circle)
+{
+    double dx = circle.center.x - Clamp(circle.center.x, rect.left, rect.right);
+    double dy = circle.center.y - Clamp(circle.center.y, rect.top, rect.bottom);
+    return dx * dx + dy * dy <= circle.radius * circle.radius;
+}
+
+// 圆形与圆形碰撞检测（比较距离的平方，避免开根号）
+constexpr bool IsCircleCircleCollision(Circle c1, Circle c2)
+{
+    double dx = c1.center.x - c2.center.x;
+    double dy = c1.center.y - c2.center.y;
+    double r = c1.radius + c2.radius;
+    return dx * dx + dy * dy <= r * r;
+}
 
 // 点在矩形内检测
-bool IsPointInRect(Vector2 p, Rect r);
+constexpr bool IsPointInRect(Vector2 p, Rect r)
+{
+    return p.x >= r.left && p.x <= r.right && p.y >= r.top && p.y <= r.bottom;
+}
 
 // 点在圆形内检测
-bool IsPointInCircle(Vector2 p, Circle c);
+constexpr bool IsPointInCircle(Vector2 p, Circle c)
+{
+    double dx = p.x - c.center.x;
+    double dy = p.y - c.center.y;
+    return dx * dx + dy * dy <= c.radius * c.radius;
+}
 
 // ===== 辅助函数 =====
-// 根据位置和大小构造矩形
-Rect CreateRect(Vector2 position, double width, double height);
+// 根据位置（左上角）和大小构造矩形
+constexpr Rect CreateRect(Vector2 position, double width, double height)
+{
+    return {position.x, position.x + width, position.y, position.y + height};
+}
 
 // 根据中心和半径构造圆形
-Circle CreateCircle(Vector2 center, double radius);
+constexpr Circle CreateCircle(Vector2 center, double radius)
+{
+    return {center, radius};
+}
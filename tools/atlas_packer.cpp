@@ -0,0 +1,267 @@
+// 精灵图集打包工具（构建时运行）
+// 读取 resource/ 中与精灵同名的 PNG（例如 player.png），装箱成一张 RGBA 图集，
+// 连同元数据表（UV 矩形、锚点）写入一个二进制文件；
+// 缺少 PNG（或构建时没有 SDL2_image）的精灵用程序生成的占位图代替，保证图集总是完整的
+//
+// 用法：atlas_packer <resource_dir> <output.atlas>
+
+#define SDL_MAIN_HANDLED
+#include "render/sprite_atlas.h"
+#include "util/config.h"
+
+#include <SDL.h>
+#ifdef AIRCOMBAT_HAVE_SDL_IMAGE
+#include <SDL_image.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int kAtlasWidth = 256;  // 图集宽度（高度由装箱结果决定）
+    const int kPadding = 2;       // 精灵之间的空隙
+
+    // 锚点位置
+    enum PivotMode
+    {
+        PIVOT_TOP_LEFT,  // 对齐到左上角（玩家、敌机的 position 是左上角）
+        PIVOT_CENTER     // 对齐到中心（子弹的 position 是圆心）
+    };
+
+    // 占位图形状
+    enum PlaceholderShape
+    {
+        SHAPE_PLANE_UP,    // 机头朝上的飞机
+        SHAPE_PLANE_DOWN,  // 机头朝下的飞机
+        SHAPE_CIRCLE       // 实心圆
+    };
+
+    // 一个精灵的打包配置
+    struct SpriteDef
+    {
+        SpriteId id;
+        int width, height;                  // 占位图尺寸
+        PivotMode pivot;
+        PlaceholderShape shape;
+        Color color;                        // 占位图颜色
+    };
+
+    const SpriteDef kSprites[SPRITE_COUNT] = {
+        {SPRITE_PLAYER, PLAYER_WIDTH, PLAYER_HEIGHT, PIVOT_TOP_LEFT, SHAPE_PLANE_UP, COLOR_BLUE},
+        {SPRITE_PLAYER2, PLAYER_WIDTH, PLAYER_HEIGHT, PIVOT_TOP_LEFT, SHAPE_PLANE_UP, COLOR_GREEN},
+        // 敌机占位图的颜色与 enemy.cpp 特性表中无图集时的颜色一致
+        {SPRITE_ENEMY, ENEMY_WIDTH, ENEMY_HEIGHT, PIVOT_TOP_LEFT, SHAPE_PLANE_DOWN, {220, 60, 60}},
+        {SPRITE_ENEMY_ZIGZAG, ENEMY_WIDTH, ENEMY_HEIGHT, PIVOT_TOP_LEFT, SHAPE_PLANE_DOWN, {230, 140, 60}},
+        {SPRITE_ENEMY_DIVER, ENEMY_WIDTH, ENEMY_HEIGHT, PIVOT_TOP_LEFT, SHAPE_PLANE_DOWN, {200, 80, 200}},
+        {SPRITE_ENEMY_TANK, ENEMY_WIDTH, ENEMY_HEIGHT, PIVOT_TOP_LEFT, SHAPE_PLANE_DOWN, {140, 40, 40}},
+        {SPRITE_ENEMY_SHOOTER, ENEMY_WIDTH, ENEMY_HEIGHT, PIVOT_TOP_LEFT, SHAPE_PLANE_DOWN, {230, 200, 60}},
+        {SPRITE_BULLET, BULLET_RADIUS * 2 + 1, BULLET_RADIUS * 2 + 1, PIVOT_CENTER, SHAPE_CIRCLE, COLOR_RED},
+        {SPRITE_ENEMY_BULLET, BULLET_RADIUS * 2 + 1, BULLET_RADIUS * 2 + 1, PIVOT_CENTER, SHAPE_CIRCLE, COLOR_YELLOW},
+    };
+
+    // 打包中的一张图
+    struct Image
+    {
+        const SpriteDef* def;
+        int w, h;
+        int x, y;                        // 在图集中的位置
+        std::vector<unsigned char> rgba;
+    };
+
+    // 飞机剖面：t 从机头(0)到机尾(1)，返回该处半宽占总宽度的比例
+    double PlaneHalfWidth(double t)
+    {
+        if (t < 0.17)
+            return 0.1 * t / 0.17;                              // 机头
+        if (t >= 0.37 && t < 0.65)
+            return 0.15 + 0.35 * std::min(1.0, (t - 0.37) / 0.2); // 主翼
+        if (t >= 0.83)
+            return 0.28;                                        // 尾翼
+        return 0.1;                                             // 机身
+    }
+
+    // 生成占位图
+    void MakePlaceholder(const SpriteDef& def, Image& image)
+    {
+        image.w = def.width;
+        image.h = def.height;
+        image.rgba.assign(static_cast<size_t>(image.w) * image.h * 4, 0);
+        for (int y = 0; y < image.h; ++y)
+        {
+            for (int x = 0; x < image.w; ++x)
+            {
+                double px = x + 0.5, py = y + 0.5;
+                bool inside;
+                if (def.shape == SHAPE_CIRCLE)
+                {
+                    double r = (image.w - 1) / 2.0;
+                    double dx = x - r, dy = y - r;
+                    inside = dx * dx + dy * dy <= r * r;
+                }
+                else
+                {
+                    double t = py / image.h;
+                    if (def.shape == SHAPE_PLANE_DOWN)
+                        t = 1.0 - t;
+                    inside = std::fabs(px - image.w / 2.0) <= PlaneHalfWidth(t) * image.w;
+                }
+                if (!inside)
+                    continue;
+                unsigned char* p = &image.rgba[(static_cast<size_t>(y) * image.w + x) * 4];
+                p[0] = def.color.r;
+                p[1] = def.color.g;
+                p[2] = def.color.b;
+                p[3] = 255;
+            }
+        }
+    }
+
+    // 尝试读取 resource/<name>.png
+    bool LoadPng(const std::string& path, Image& image)
+    {
+#ifdef AIRCOMBAT_HAVE_SDL_IMAGE
+        SDL_Surface* loaded = IMG_Load(path.c_str());
+        if (!loaded)
+            return false;
+        SDL_Surface* surface = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loaded);
+        if (!surface)
+            return false;
+
+        image.w = surface->w;
+        image.h = surface->h;
+        image.rgba.resize(static_cast<size_t>(image.w) * image.h * 4);
+        SDL_LockSurface(surface);
+        for (int y = 0; y < image.h; ++y)
+        {
+            std::memcpy(&image.rgba[static_cast<size_t>(y) * image.w * 4],
+                        static_cast<const unsigned char*>(surface->pixels) + y * surface->pitch,
+                        static_cast<size_t>(image.w) * 4);
+        }
+        SDL_UnlockSurface(surface);
+        SDL_FreeSurface(surface);
+        return true;
+#else
+        (void)path;
+        (void)image;
+        return false;
+#endif
+    }
+
+    void WriteU16(FILE* f, unsigned int v)
+    {
+        unsigned char b[2] = {static_cast<unsigned char>(v), static_cast<unsigned char>(v >> 8)};
+        std::fwrite(b, 1, 2, f);
+    }
+
+    void WriteU32(FILE* f, unsigned int v)
+    {
+        unsigned char b[4] = {static_cast<unsigned char>(v), static_cast<unsigned char>(v >> 8),
+                              static_cast<unsigned char>(v >> 16), static_cast<unsigned char>(v >> 24)};
+        std::fwrite(b, 1, 4, f);
+    }
+
+    void WriteF32(FILE* f, float v)
+    {
+        unsigned int bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        WriteU32(f, bits);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::fprintf(stderr, "usage: %s <resource_dir> <output.atlas>\n", argv[0]);
+        return 1;
+    }
+    std::string resourceDir = argv[1];
+
+    // ===== 读取或生成每个精灵 =====
+    std::vector<Image> images(SPRITE_COUNT);
+    for (int i = 0; i < SPRITE_COUNT; ++i)
+    {
+        Image& image = images[i];
+        image.def = &kSprites[i];
+        std::string path = resourceDir + "/" + GetSpriteName(kSprites[i].id) + ".png";
+        if (LoadPng(path, image))
+            std::printf("atlas_packer: %s <- %s\n", GetSpriteName(kSprites[i].id), path.c_str());
+        else
+            MakePlaceholder(kSprites[i], image);
+
+        if (image.w > kAtlasWidth - 2 * kPadding)
+        {
+            std::fprintf(stderr, "atlas_packer: %s is wider than the atlas\n", path.c_str());
+            return 1;
+        }
+    }
+
+    // ===== 货架装箱：按高度从高到低放置 =====
+    std::vector<Image*> order;
+    for (Image& image : images)
+        order.push_back(&image);
+    std::sort(order.begin(), order.end(), [](const Image* a, const Image* b) { return a->h > b->h; });
+
+    int penX = kPadding, penY = kPadding, rowHeight = 0;
+    for (Image* image : order)
+    {
+        if (penX + image->w + kPadding > kAtlasWidth)
+        {
+            penX = kPadding;
+            penY += rowHeight + kPadding;
+            rowHeight = 0;
+        }
+        image->x = penX;
+        image->y = penY;
+        penX += image->w + kPadding;
+        rowHeight = std::max(rowHeight, image->h);
+    }
+    int atlasHeight = penY + rowHeight + kPadding;
+
+    std::vector<unsigned char> atlas(static_cast<size_t>(kAtlasWidth) * atlasHeight * 4, 0);
+    for (const Image& image : images)
+    {
+        for (int y = 0; y < image.h; ++y)
+        {
+            std::memcpy(&atlas[(static_cast<size_t>(image.y + y) * kAtlasWidth + image.x) * 4],
+                        &image.rgba[static_cast<size_t>(y) * image.w * 4], static_cast<size_t>(image.w) * 4);
+        }
+    }
+
+    // ===== 写出文件头、元数据表、像素 =====
+    FILE* out = std::fopen(argv[2], "wb");
+    if (!out)
+    {
+        std::fprintf(stderr, "atlas_packer: cannot write %s\n", argv[2]);
+        return 1;
+    }
+    WriteU32(out, SPRITE_ATLAS_MAGIC);
+    WriteU32(out, SPRITE_ATLAS_VERSION);
+    WriteU32(out, kAtlasWidth);
+    WriteU32(out, static_cast<unsigned int>(atlasHeight));
+    WriteU32(out, SPRITE_COUNT);
+    for (const Image& image : images)
+    {
+        char name[SPRITE_NAME_LENGTH] = {};
+        std::strncpy(name, GetSpriteName(image.def->id), SPRITE_NAME_LENGTH - 1);
+        std::fwrite(name, 1, SPRITE_NAME_LENGTH, out);
+        WriteU16(out, static_cast<unsigned int>(image.x));
+        WriteU16(out, static_cast<unsigned int>(image.y));
+        WriteU16(out, static_cast<unsigned int>(image.w));
+        WriteU16(out, static_cast<unsigned int>(image.h));
+        bool center = image.def->pivot == PIVOT_CENTER;
+        WriteF32(out, center ? image.w / 2 : 0.0f);
+        WriteF32(out, center ? image.h / 2 : 0.0f);
+    }
+    std::fwrite(atlas.data(), 1, atlas.size(), out);
+    std::fclose(out);
+
+    std::printf("atlas_packer: %d sprites, atlas %dx%d\n", SPRITE_COUNT, kAtlasWidth, atlasHeight);
+    return 0;
+}
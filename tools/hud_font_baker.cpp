@@ -0,0 +1,181 @@
+// HUD 字体烘焙工具（构建时运行）
+// 用 SDL_ttf 把 HUD 需要的可打印 ASCII 字形光栅化，装箱成一张 4 位灰度图集，
+// 输出可直接编译进游戏的 C++ 源文件
+//
+// 用法：hud_font_baker <font.ttf> <size> <output.cpp>
+
+#define SDL_MAIN_HANDLED
+#include "ui/hud_font.h"
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    const int kAtlasWidth = 256;  // 图集宽度（高度由装箱结果决定）
+    const int kPadding = 1;       // 字形之间的空隙，避免线性采样串色
+
+    // 烘焙过程中的一个字形
+    struct BakedGlyph
+    {
+        HudGlyph info;
+        std::vector<unsigned char> alpha;  // 裁剪后的 8 位透明度
+    };
+
+    // 光栅化一个字符并裁剪掉四周的透明像素
+    bool BakeGlyph(TTF_Font* font, Uint16 ch, BakedGlyph& out)
+    {
+        int minX, maxX, minY, maxY, advance;
+        if (TTF_GlyphMetrics(font, ch, &minX, &maxX, &minY, &maxY, &advance) != 0)
+            return false;
+        out.info = {};
+        out.info.advance = static_cast<short>(advance);
+
+        SDL_Surface* rendered = TTF_RenderGlyph_Blended(font, ch, SDL_Color{255, 255, 255, 255});
+        if (!rendered)
+            return true;  // 空格等空白字形：只有前进距离
+        SDL_Surface* surface = SDL_ConvertSurfaceFormat(rendered, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(rendered);
+        if (!surface)
+            return false;
+
+        SDL_LockSurface(surface);
+        const unsigned char* base = static_cast<const unsigned char*>(surface->pixels);
+        auto alphaAt = [&](int x, int y) {
+            const Uint32* row = reinterpret_cast<const Uint32*>(base + y * surface->pitch);
+            return static_cast<unsigned char>(row[x] >> 24);
+        };
+
+        // 找到非透明像素的包围盒
+        int left = surface->w, right = -1, top = surface->h, bottom = -1;
+        for (int y = 0; y < surface->h; ++y)
+        {
+            for (int x = 0; x < surface->w; ++x)
+            {
+                if (alphaAt(x, y) == 0)
+                    continue;
+                left = x < left ? x : left;
+                right = x > right ? x : right;
+                top = y < top ? y : top;
+                bottom = y > bottom ? y : bottom;
+            }
+        }
+
+        if (right >= left)
+        {
+            out.info.w = static_cast<short>(right - left + 1);
+            out.info.h = static_cast<short>(bottom - top + 1);
+            out.info.offsetX = static_cast<short>(left);
+            out.info.offsetY = static_cast<short>(top);  // 字形表面高度等于行高，top 即相对行顶部的偏移
+            out.alpha.resize(static_cast<size_t>(out.info.w) * out.info.h);
+            for (int y = 0; y < out.info.h; ++y)
+                for (int x = 0; x < out.info.w; ++x)
+                    out.alpha[y * out.info.w + x] = alphaAt(left + x, top + y);
+        }
+
+        SDL_UnlockSurface(surface);
+        SDL_FreeSurface(surface);
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 4)
+    {
+        std::fprintf(stderr, "usage: %s <font.ttf> <size> <output.cpp>\n", argv[0]);
+        return 1;
+    }
+
+    if (TTF_Init() != 0)
+    {
+        std::fprintf(stderr, "hud_font_baker: TTF_Init failed: %s\n", TTF_GetError());
+        return 1;
+    }
+    TTF_Font* font = TTF_OpenFont(argv[1], std::atoi(argv[2]));
+    if (!font)
+    {
+        std::fprintf(stderr, "hud_font_baker: cannot open %s: %s\n", argv[1], TTF_GetError());
+        TTF_Quit();
+        return 1;
+    }
+
+    // ===== 光栅化所有字形 =====
+    std::vector<BakedGlyph> glyphs(HUD_FONT_GLYPH_COUNT);
+    for (int i = 0; i < HUD_FONT_GLYPH_COUNT; ++i)
+    {
+        if (!BakeGlyph(font, static_cast<Uint16>(HUD_FONT_FIRST_CHAR + i), glyphs[i]))
+        {
+            std::fprintf(stderr, "hud_font_baker: failed to rasterize '%c'\n", HUD_FONT_FIRST_CHAR + i);
+            TTF_CloseFont(font);
+            TTF_Quit();
+            return 1;
+        }
+    }
+    int lineHeight = TTF_FontHeight(font);
+    TTF_CloseFont(font);
+    TTF_Quit();
+
+    // ===== 按行装箱（字形高度接近，简单的货架算法即可）=====
+    int penX = kPadding, penY = kPadding, rowHeight = 0;
+    for (BakedGlyph& g : glyphs)
+    {
+        if (g.info.w == 0)
+            continue;
+        if (penX + g.info.w + kPadding > kAtlasWidth)
+        {
+            penX = kPadding;
+            penY += rowHeight + kPadding;
+            rowHeight = 0;
+        }
+        g.info.x = static_cast<short>(penX);
+        g.info.y = static_cast<short>(penY);
+        penX += g.info.w + kPadding;
+        rowHeight = g.info.h > rowHeight ? g.info.h : rowHeight;
+    }
+    int atlasHeight = penY + rowHeight + kPadding;
+
+    // ===== 量化为 4 位透明度，每字节两个像素 =====
+    std::vector<unsigned char> pixels(static_cast<size_t>(kAtlasWidth) * atlasHeight / 2 + 1, 0);
+    for (const BakedGlyph& g : glyphs)
+    {
+        for (int y = 0; y < g.info.h; ++y)
+        {
+            for (int x = 0; x < g.info.w; ++x)
+            {
+                int index = (g.info.y + y) * kAtlasWidth + g.info.x + x;
+                unsigned char nibble = static_cast<unsigned char>((g.alpha[y * g.info.w + x] * 15 + 127) / 255);
+                pixels[index / 2] |= static_cast<unsigned char>((index & 1) ? nibble << 4 : nibble);
+            }
+        }
+    }
+
+    // ===== 输出源文件 =====
+    FILE* out = std::fopen(argv[3], "w");
+    if (!out)
+    {
+        std::fprintf(stderr, "hud_font_baker: cannot write %s\n", argv[3]);
+        return 1;
+    }
+    std::fprintf(out, "// 由 tools/hud_font_baker 根据 %s 自动生成，请勿手动修改\n", argv[1]);
+    std::fprintf(out, "#include \"ui/hud_font.h\"\n\nnamespace\n{\n    const unsigned char kPixels[] = {");
+    for (size_t i = 0; i < pixels.size(); ++i)
+        std::fprintf(out, "%s%u,", (i % 24 == 0) ? "\n        " : "", pixels[i]);
+    std::fprintf(out, "\n    };\n\n    const HudFontAtlas kAtlas = {\n");
+    std::fprintf(out, "        %d, %d, %d,\n        kPixels,\n        {", kAtlasWidth, atlasHeight, lineHeight);
+    for (const BakedGlyph& g : glyphs)
+    {
+        std::fprintf(out, "\n            {%d, %d, %d, %d, %d, %d, %d},",
+                     g.info.x, g.info.y, g.info.w, g.info.h, g.info.offsetX, g.info.offsetY, g.info.advance);
+    }
+    std::fprintf(out, "\n        }\n    };\n}\n\nconst HudFontAtlas& GetHudFontAtlas()\n{\n    return kAtlas;\n}\n");
+    std::fclose(out);
+
+    std::printf("hud_font_baker: %d glyphs, atlas %dx%d, %zu bytes\n",
+                HUD_FONT_GLYPH_COUNT, kAtlasWidth, atlasHeight, pixels.size());
+    return 0;
+}
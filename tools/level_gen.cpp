@@ -0,0 +1,36 @@
+// 纵向卷轴关卡生成工具
+// 按固定种子生成一个随机关卡文件（格式见 src/level/level.h），供 AirCombat --level 使用
+//
+// 用法：level_gen <out.aclv> [chunks] [seed]    默认 40 块（约 6 分钟）、种子 1
+
+#define SDL_MAIN_HANDLED
+#include "level/level.h"
+#include "util/config.h"
+
+#include <SDL.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <out.aclv> [chunks] [seed]\n", argv[0]);
+        return 2;
+    }
+    int chunks = argc > 2 ? std::atoi(argv[2]) : 40;
+    unsigned int seed = argc > 3 ? static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10)) : 1u;
+    if (chunks <= 0)
+    {
+        std::fprintf(stderr, "chunks must be positive\n");
+        return 2;
+    }
+
+    if (!LevelGenerate(argv[1], chunks, seed))
+        return 1;
+    std::printf("%s: %d chunks, %.0f px (%.0f s at %.0f px/s)\n", argv[1], chunks,
+                chunks * static_cast<double>(LEVEL_CHUNK_HEIGHT), chunks * LEVEL_CHUNK_HEIGHT / LEVEL_SCROLL_SPEED,
+                LEVEL_SCROLL_SPEED);
+    return 0;
+}
@@ -0,0 +1,222 @@
+// 二进制日志转文字工具
+// 读取 --log 写出的文件（格式见 src/util/log.h），按文件头中的格式串还原每条记录，
+// 按 tick 排序后每条一行：tick  该 tick 开始的时间（毫秒）  线程  消息
+// 结尾在标准错误输出各类消息的条数和丢弃总数
+//
+// 用法：log_dump <input> [output.txt]    不指定输出文件时写到标准输出
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const uint32_t kVersion = 1;
+    const int kMaxArgs = 4;
+
+    struct MessageFormat
+    {
+        std::string name;
+        int argCount;
+        std::string format;
+    };
+
+    struct Record
+    {
+        uint32_t tick;
+        uint16_t message;
+        uint8_t thread;
+        double args[kMaxArgs];
+    };
+
+    bool ReadBytes(FILE* file, void* data, size_t size)
+    {
+        return std::fread(data, 1, size, file) == size;
+    }
+
+    bool ReadU16(FILE* file, uint32_t& value)
+    {
+        uint8_t bytes[2];
+        if (!ReadBytes(file, bytes, 2))
+            return false;
+        value = static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8;
+        return true;
+    }
+
+    bool ReadU32(FILE* file, uint32_t& value)
+    {
+        uint32_t low = 0, high = 0;
+        if (!ReadU16(file, low) || !ReadU16(file, high))
+            return false;
+        value = low | high << 16;
+        return true;
+    }
+
+    bool ReadF64(FILE* file, double& value)
+    {
+        uint32_t low = 0, high = 0;
+        if (!ReadU32(file, low) || !ReadU32(file, high))
+            return false;
+        uint64_t bits = static_cast<uint64_t>(high) << 32 | low;
+        std::memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+
+    bool ReadString(FILE* file, uint32_t length, std::string& out)
+    {
+        out.resize(length);
+        return length == 0 || ReadBytes(file, &out[0], length);
+    }
+
+    // 按格式串展开参数：%d/%i 类转换取整，其余（%f 等）按浮点数，%% 原样输出
+    // 格式串来自文件：% 与转换字母之间只接受标志、宽度和精度（[-+ #0-9.]），
+    // 其他写法（*、n、长度修饰符等）不交给 snprintf，按原文输出
+    std::string FormatRecord(const MessageFormat& format, const Record& record)
+    {
+        std::string text;
+        const std::string& f = format.format;
+        int arg = 0;
+        char piece[64];
+        for (size_t i = 0; i < f.size(); ++i)
+        {
+            if (f[i] != '%')
+            {
+                text += f[i];
+                continue;
+            }
+            if (i + 1 < f.size() && f[i + 1] == '%')
+            {
+                text += '%';
+                ++i;
+                continue;
+            }
+            size_t end = f.find_first_not_of("-+ #0123456789.", i + 1);
+            if (end == std::string::npos || end - i >= 16 || f[end] == '\0' ||
+                std::strchr("diufeEgG", f[end]) == nullptr)
+            {
+                text += '%';
+                continue;
+            }
+            std::string spec = f.substr(i, end - i + 1);
+            double value = arg < format.argCount ? record.args[arg] : 0.0;
+            arg++;
+            if (f[end] == 'd' || f[end] == 'i' || f[end] == 'u')
+                std::snprintf(piece, sizeof(piece), spec.c_str(), static_cast<int>(value));
+            else
+                std::snprintf(piece, sizeof(piece), spec.c_str(), value);
+            text += piece;
+            i = end;
+        }
+        return text;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: log_dump <input> [output.txt]\n");
+        return 2;
+    }
+
+    FILE* in = std::fopen(argv[1], "rb");
+    if (!in)
+    {
+        std::fprintf(stderr, "log_dump: cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    // ===== 文件头 =====
+    char magic[4];
+    uint32_t version = 0, messageCount = 0;
+    if (!ReadBytes(in, magic, 4) || std::memcmp(magic, "ACLG", 4) != 0 || !ReadU32(in, version) ||
+        version != kVersion || !ReadU32(in, messageCount) || messageCount == 0)
+    {
+        std::fprintf(stderr, "log_dump: %s is not a log file (or has an unknown version)\n", argv[1]);
+        std::fclose(in);
+        return 1;
+    }
+
+    std::vector<MessageFormat> formats(messageCount);
+    for (MessageFormat& format : formats)
+    {
+        uint8_t nameLength = 0, argCount = 0;
+        uint32_t formatLength = 0;
+        if (!ReadBytes(in, &nameLength, 1) || !ReadString(in, nameLength, format.name) ||
+            !ReadBytes(in, &argCount, 1) || argCount > kMaxArgs || !ReadU16(in, formatLength) ||
+            !ReadString(in, formatLength, format.format))
+        {
+            std::fprintf(stderr, "log_dump: truncated header\n");
+            std::fclose(in);
+            return 1;
+        }
+        format.argCount = argCount;
+    }
+
+    // ===== 记录 =====
+    // 后台线程按环形缓冲逐个写出，不同线程的记录在文件中交错，读完后再按 tick 排序
+    std::vector<Record> records;
+    int result = 0;
+    uint32_t tick = 0;
+    while (ReadU32(in, tick))
+    {
+        Record record = {};
+        record.tick = tick;
+        uint32_t message = 0;
+        uint8_t argCount = 0;
+        bool ok = ReadU16(in, message) && ReadBytes(in, &record.thread, 1) && ReadBytes(in, &argCount, 1) &&
+                  message < messageCount && argCount <= kMaxArgs;
+        for (int i = 0; ok && i < argCount; ++i)
+            ok = ReadF64(in, record.args[i]);
+        if (!ok)
+        {
+            std::fprintf(stderr, "log_dump: record %zu is truncated or corrupt\n", records.size());
+            result = 1;
+            break;
+        }
+        record.message = static_cast<uint16_t>(message);
+        records.push_back(record);
+    }
+    std::fclose(in);
+    std::stable_sort(records.begin(), records.end(),
+                     [](const Record& a, const Record& b) { return a.tick < b.tick; });
+
+    FILE* out = argc >= 3 ? std::fopen(argv[2], "w") : stdout;
+    if (!out)
+    {
+        std::fprintf(stderr, "log_dump: cannot write %s\n", argv[2]);
+        return 1;
+    }
+
+    // 第 0 条消息（tick）只用来给之后的记录标时间，不单独输出；第 1 条（dropped）计入丢弃总数
+    std::vector<long long> counts(messageCount, 0);
+    long long dropped = 0;
+    double tickMs = 0.0;
+    for (const Record& record : records)
+    {
+        counts[record.message]++;
+        if (record.message == 0)
+        {
+            tickMs = record.args[0];
+            continue;
+        }
+        if (record.message == 1)
+            dropped += static_cast<long long>(record.args[0]);
+        std::fprintf(out, "%8u %12.3f  t%u  %s\n", record.tick, tickMs, record.thread,
+                     FormatRecord(formats[record.message], record).c_str());
+    }
+    if (out != stdout)
+        std::fclose(out);
+
+    std::fprintf(stderr, "log_dump: %zu records, %lld dropped\n", records.size(), dropped);
+    for (uint32_t m = 0; m < messageCount; ++m)
+    {
+        if (counts[m] > 0)
+            std::fprintf(stderr, "  %-16s %lld\n", formats[m].name.c_str(), counts[m]);
+    }
+    return result;
+}
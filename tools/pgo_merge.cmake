@@ -0,0 +1,14 @@
+# 合并 Clang 的原始剖析数据（pgo_train 的最后一步）
+# cmake -DLLVM_PROFDATA=<llvm-profdata> -DPGO_DIR=<dir> -P pgo_merge.cmake
+# 把 PGO_DIR 下所有 *.profraw 合并为 PGO_DIR/default.profdata（-fprofile-use=<dir> 读取的文件名）
+file(GLOB PROFRAW_FILES ${PGO_DIR}/*.profraw)
+if(NOT PROFRAW_FILES)
+    message(FATAL_ERROR "No .profraw files in ${PGO_DIR} - was the GENERATE build run?")
+endif()
+execute_process(
+    COMMAND ${LLVM_PROFDATA} merge -output=${PGO_DIR}/default.profdata ${PROFRAW_FILES}
+    RESULT_VARIABLE MERGE_RESULT
+)
+if(NOT MERGE_RESULT EQUAL 0)
+    message(FATAL_ERROR "llvm-profdata merge failed")
+endif()
@@ -0,0 +1,490 @@
+// 场景性能回归测试（无窗口、无 GPU）
+// 用脚本化的输入驱动 GameInit / GameUpdate，固定步长运行一个命名场景，
+// 统计每个 tick 的耗时，把指标写成 JSON，并与仓库中提交的基线比较
+//
+// 用法：scenario_runner <scenario> [--output DIR] [--baseline DIR] [--tolerance T] [--update-baseline]
+//                       [--repeat N] [--telemetry FILE] [--log FILE]
+//       scenario_runner --list
+// 场景重复运行 N 次（默认 5），每次之后运行一遍固定的校准负载，各指标取 N 次的中位数。
+// 与基线比较的是按校准耗时归一化的吞吐量（ticks/sec × 校准毫秒数），换一台机器基本不变；
+// p99 波动太大，只报告不判定
+// --telemetry 同时把每个 tick 的统计写入 FILE（与游戏的 --telemetry 格式相同）
+// --log 同时写二进制日志（与游戏的 --log 格式相同）
+// 每个场景单独启动一个进程运行，峰值内存互不影响
+
+#define SDL_MAIN_HANDLED
+#include "audio/audio.h"
+#include "core/core.h"
+#include "game_object/boss.h"
+#include "game_object/bullet.h"
+#include "game_object/enemy.h"
+#include "game_object/particle.h"
+#include "input/input.h"
+#include "level/level.h"
+#include "util/config.h"
+#include "util/log.h"
+#include "util/telemetry.h"
+#include "util/util.h"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    // 场景定义：除了游戏本身的生成节奏外，可以额外生成敌机和子弹来制造负载
+    struct Scenario
+    {
+        const char* name;
+        const char* description;
+        int ticks;                      // 运行的 tick 数（固定步长 1 / TARGET_FPS）
+        double extraEnemiesPerSecond;   // 额外生成的敌机（屏幕上方随机位置）
+        double extraBulletsPerSecond;   // 额外生成的子弹（从屏幕底部均匀铺开向上飞）
+        double patternBulletsPerSecond; // 额外生成的弹幕子弹（四种弹道轮流，从屏幕中央环形发射）
+        int sweepTicks;                 // 玩家左右往返一次的 tick 数
+        int bosses;                     // 始终保持在场的 Boss 数量（被消灭后立即补上）
+        double levelScrollSpeed;        // > 0 时生成一个刚好够长的关卡文件，以该速度（像素/秒）卷轴
+        bool mixedEnemies;              // 额外生成的敌机按出现权重随机选类型（否则全是基础型）
+        int particleFloor;              // > 0 时每个 tick 在随机位置生成爆炸，把粒子数补到该值
+        double minTolerance;            // 该场景与基线比较时的最小容差（大于 --tolerance 时代替它）
+    };
+
+    const Scenario kScenarios[] = {
+        {"light_play", "normal spawn rate, player fires and sweeps", 60 * 60, 0.0, 0.0, 0.0, 120, 0, 0.0, false, 0, 0.0},
+        {"heavy_spawn", "60 extra enemies per second", 60 * 60, 60.0, 0.0, 0.0, 120, 0, 0.0, false, 0, 0.0},
+        {"bullet_spam", "600 extra bullets per second", 60 * 60, 0.0, 600.0, 0.0, 120, 0, 0.0, false, 0, 0.0},
+        {"pattern_storm", "3000 sine/spiral/accelerating pattern bullets per second", 60 * 60, 0.0, 0.0, 3000.0, 120, 0, 0.0, false, 0, 0.0},
+        // 轻负载时每个 tick 只有几微秒，偶发的调度抖动占比很大：跑满一小时后单个进程内的波动约 ±7%，
+        // 但不同进程之间的中位数仍相差近 ±15%，因此单独放宽容差
+        {"long_session", "an hour of light play", 60 * 60 * 60, 0.0, 0.0, 0.0, 120, 0, 0.0, false, 0, 0.4},
+        {"boss_stream", "two multi-part bosses under a 1200 bullets per second stream", 60 * 60, 0.0, 1200.0, 0.0, 120, 2, 0.0, false, 0, 0.0},
+        {"level_stream", "level streamed from a memory-mapped file at 3000 px/s", 60 * 60, 0.0, 0.0, 0.0, 120, 0, 3000.0, false, 0, 0.0},
+        {"enemy_mix", "60 extra enemies per second across all enemy types", 60 * 60, 60.0, 0.0, 0.0, 120, 0, 0.0, true, 0, 0.0},
+        {"particle_storm", "particle ring held at the 200k budget with random explosions", 60 * 60, 0.0, 0.0, 0.0, 120, 0, 0.0, false, PARTICLE_BUDGET, 0.0},
+    };
+
+    const unsigned int kSeed = 12345;  // 固定随机种子，保证每次运行的场景完全相同
+
+    // 一次运行的指标
+    struct Metrics
+    {
+        int ticks;
+        double ticksPerSec;
+        double p50Ms;
+        double p99Ms;
+        double maxMs;
+        long peakRssKb;
+        double calibrationMs;   // 同一次运行之后校准负载的耗时
+        int finalEnemies;
+        int finalBullets;
+        int finalParticles;
+    };
+
+    const Scenario* FindScenario(const char* name)
+    {
+        for (const Scenario& s : kScenarios)
+        {
+            if (std::strcmp(s.name, name) == 0)
+                return &s;
+        }
+        return nullptr;
+    }
+
+    // 进程的峰值常驻内存（KB）
+    long GetPeakRssKb()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters = {};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return static_cast<long>(counters.PeakWorkingSetSize / 1024);
+        return 0;
+#else
+        struct rusage usage = {};
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return static_cast<long>(usage.ru_maxrss / 1024);  // macOS 以字节为单位
+#else
+        return static_cast<long>(usage.ru_maxrss);
+#endif
+#endif
+    }
+
+    double Percentile(std::vector<double> samples, double fraction)
+    {
+        if (samples.empty())
+            return 0.0;
+        size_t index = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + static_cast<long>(index), samples.end());
+        return samples[index];
+    }
+
+    volatile unsigned int g_calibrationSink = 0;
+
+    // 校准负载：与游戏无关的固定计算（浮点数组积分 + 整数排序），耗时只取决于机器和编译选项，
+    // 用来把吞吐量换算成与机器快慢无关的数值
+    double RunCalibration()
+    {
+        const int kCount = 1 << 16;
+        std::vector<float> position(kCount), velocity(kCount);
+        std::vector<unsigned int> keys(kCount);
+        unsigned int state = kSeed;
+        for (int i = 0; i < kCount; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            keys[i] = state;
+            position[i] = static_cast<float>(state & 0xFFFFu);
+            velocity[i] = static_cast<float>(state >> 16) * 0.001f;
+        }
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int pass = 0; pass < 64; ++pass)
+        {
+            for (int i = 0; i < kCount; ++i)
+            {
+                velocity[i] += 0.3f * (1.0f / 60.0f);
+                position[i] += velocity[i] * (1.0f / 60.0f);
+            }
+        }
+        for (int pass = 0; pass < 4; ++pass)
+        {
+            std::sort(keys.begin(), keys.end());
+            for (unsigned int& key : keys)
+                key = key * 2654435761u + static_cast<unsigned int>(position[key & (kCount - 1)]);
+        }
+        double ms = static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 /
+                    static_cast<double>(SDL_GetPerformanceFrequency());
+
+        // 让结果被用到，整段计算不会被优化掉
+        g_calibrationSink = keys[0] + keys[kCount - 1];
+        return ms;
+    }
+
+    double Median(std::vector<double> values)
+    {
+        return Percentile(std::move(values), 0.5);
+    }
+
+    // 多次运行逐项取中位数（结束时的实体数每次都相同，取第一次的）
+    Metrics MedianMetrics(const std::vector<Metrics>& runs)
+    {
+        auto median = [&runs](double Metrics::*field) {
+            std::vector<double> values;
+            for (const Metrics& run : runs)
+                values.push_back(run.*field);
+            return Median(values);
+        };
+        Metrics m = runs.front();
+        m.ticksPerSec = median(&Metrics::ticksPerSec);
+        m.p50Ms = median(&Metrics::p50Ms);
+        m.p99Ms = median(&Metrics::p99Ms);
+        m.maxMs = median(&Metrics::maxMs);
+        m.calibrationMs = median(&Metrics::calibrationMs);
+        m.peakRssKb = runs.back().peakRssKb;
+        return m;
+    }
+
+    // 第 n 颗弹幕子弹的弹道：四种弹道轮流，方向绕圆周旋转
+    BulletTrajectory PatternTrajectory(int n)
+    {
+        const double kPi = 3.14159265358979323846;
+        double angle = n * 0.2;
+        BulletTrajectory t = {};
+        t.motion = static_cast<BulletMotion>(n % 4);
+        t.origin = {GAME_WIDTH / 2.0, GAME_HEIGHT / 3.0};
+        t.velocity = {std::cos(angle) * 250.0, std::sin(angle) * 250.0};
+        t.acceleration = {0.0, 200.0};
+        t.amplitude = t.motion == BULLET_MOTION_SPIRAL ? 0.0 : 25.0;
+        t.angularSpeed = t.motion == BULLET_MOTION_SPIRAL ? kPi : 10.0;
+        t.phase = angle;
+        t.radialSpeed = 150.0;
+        return t;
+    }
+
+    Metrics RunScenario(const Scenario& scenario, const std::string& levelPath)
+    {
+        SetRandomSeed(kSeed);
+        GameInit();
+        if (!levelPath.empty())
+        {
+            LevelOpen(levelPath.c_str());
+            SetLevelScrollSpeed(scenario.levelScrollSpeed);
+        }
+
+        const double dt = 1.0 / TARGET_FPS;
+        const double freq = static_cast<double>(SDL_GetPerformanceFrequency());
+        std::vector<double> tickMs(static_cast<size_t>(scenario.ticks));
+        double enemyAccumulator = 0.0;
+        double bulletAccumulator = 0.0;
+        int bulletLane = 0;
+        double patternAccumulator = 0.0;
+        int patternIndex = 0;
+        double totalMs = 0.0;
+
+        for (int tick = 0; tick < scenario.ticks; ++tick)
+        {
+            // 脚本输入：一直按住开火，按固定周期左右往返
+            bool right = (tick / (scenario.sweepTicks / 2)) % 2 != 0;
+            GameSetInputOverride(true, INPUT_FIRE | (right ? INPUT_RIGHT : INPUT_LEFT));
+
+            Uint64 start = SDL_GetPerformanceCounter();
+
+            // 额外负载（计入 tick 耗时：它们和正常生成走同一条路径）
+            enemyAccumulator += scenario.extraEnemiesPerSecond * dt;
+            for (; enemyAccumulator >= 1.0; enemyAccumulator -= 1.0)
+                CreateRandomEnemy(scenario.mixedEnemies ? RandomEnemyType() : ENEMY_TYPE_BASIC);
+            bulletAccumulator += scenario.extraBulletsPerSecond * dt;
+            for (; bulletAccumulator >= 1.0; bulletAccumulator -= 1.0)
+            {
+                double x = (bulletLane++ % 50 + 0.5) * GAME_WIDTH / 50.0;
+                CreateBullet(x, GAME_HEIGHT, BULLET_DAMAGE, BULLET_SPEED, 0);
+            }
+            patternAccumulator += scenario.patternBulletsPerSecond * dt;
+            for (; patternAccumulator >= 1.0; patternAccumulator -= 1.0)
+                CreateBulletWithTrajectory(PatternTrajectory(patternIndex++), GetBulletTime(), BULLET_DAMAGE, 0);
+            // 每个 tick 至多补上限的 1/15，同一批到期的粒子不会让某一个 tick 的生成量突增
+            int particleRoom = std::min(scenario.particleFloor - GetParticleCount(), scenario.particleFloor / 15);
+            for (int n = 0; n < particleRoom; n += EXPLOSION_PARTICLES)
+                SpawnExplosion(GetRandomDouble(0.0, GAME_WIDTH), GetRandomDouble(0.0, GAME_HEIGHT));
+            // 两个 Boss 并排停在上方
+            for (int b = static_cast<int>(GetBosses().size()); b < scenario.bosses; ++b)
+                CreateBoss(b * GAME_WIDTH / 2.0 + 40.0, BOSS_HOVER_Y);
+
+            GameUpdate(dt);
+
+            double ms = static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / freq;
+            tickMs[static_cast<size_t>(tick)] = ms;
+            totalMs += ms;
+        }
+
+        Metrics m = {};
+        m.ticks = scenario.ticks;
+        m.ticksPerSec = totalMs > 0.0 ? scenario.ticks * 1000.0 / totalMs : 0.0;
+        m.p50Ms = Percentile(tickMs, 0.50);
+        m.p99Ms = Percentile(tickMs, 0.99);
+        m.maxMs = *std::max_element(tickMs.begin(), tickMs.end());
+        m.peakRssKb = GetPeakRssKb();
+        m.finalEnemies = GetEnemyCount();
+        m.finalBullets = static_cast<int>(GetBullets().size());
+        m.finalParticles = GetParticleCount();
+
+        LevelClose();
+        GameShutdown();
+        return m;
+    }
+
+    bool WriteMetrics(const std::string& path, const Scenario& scenario, const Metrics& m)
+    {
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (!file)
+        {
+            std::fprintf(stderr, "scenario_runner: cannot write %s\n", path.c_str());
+            return false;
+        }
+        std::fprintf(file,
+                     "{\n"
+                     "  \"scenario\": \"%s\",\n"
+                     "  \"ticks\": %d,\n"
+                     "  \"ticks_per_sec\": %.1f,\n"
+                     "  \"p50_tick_ms\": %.4f,\n"
+                     "  \"p99_tick_ms\": %.4f,\n"
+                     "  \"max_tick_ms\": %.4f,\n"
+                     "  \"peak_rss_kb\": %ld,\n"
+                     "  \"calibration_ms\": %.3f,\n"
+                     "  \"final_enemies\": %d,\n"
+                     "  \"final_bullets\": %d,\n"
+                     "  \"final_particles\": %d\n"
+                     "}\n",
+                     scenario.name, m.ticks, m.ticksPerSec, m.p50Ms, m.p99Ms, m.maxMs, m.peakRssKb, m.calibrationMs,
+                     m.finalEnemies, m.finalBullets, m.finalParticles);
+        std::fclose(file);
+        return true;
+    }
+
+    // 从 JSON 文本中读取一个数值字段（只处理本工具自己写出的扁平格式）
+    bool ReadNumber(const std::string& json, const char* key, double& value)
+    {
+        std::string pattern = std::string("\"") + key + "\":";
+        size_t pos = json.find(pattern);
+        if (pos == std::string::npos)
+            return false;
+        value = std::strtod(json.c_str() + pos + pattern.size(), nullptr);
+        return true;
+    }
+
+    bool ReadFile(const std::string& path, std::string& text)
+    {
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file)
+            return false;
+        char buffer[4096];
+        size_t n;
+        while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+            text.append(buffer, n);
+        std::fclose(file);
+        return true;
+    }
+
+    // 与基线比较：归一化吞吐量不能低于基线的 (1 - T)，峰值内存不能高于基线的 (1 + T)；
+    // 原始吞吐量和 p99 只列出供参考
+    bool CompareWithBaseline(const std::string& path, const Metrics& m, double tolerance)
+    {
+        std::string json;
+        if (!ReadFile(path, json))
+        {
+            std::printf("  no baseline at %s (run with --update-baseline to create it)\n", path.c_str());
+            return true;
+        }
+
+        double baseTicksPerSec = 0.0, baseP99 = 0.0, baseRss = 0.0, baseCalibration = 0.0;
+        if (!ReadNumber(json, "ticks_per_sec", baseTicksPerSec) || !ReadNumber(json, "p99_tick_ms", baseP99) ||
+            !ReadNumber(json, "peak_rss_kb", baseRss) || !ReadNumber(json, "calibration_ms", baseCalibration))
+        {
+            std::printf("  baseline %s is missing fields (run with --update-baseline to recreate it)\n", path.c_str());
+            return false;
+        }
+
+        bool ok = true;
+        auto report = [&](const char* name, double value, double baseline, bool higherIsBetter, bool gated) {
+            double limit = higherIsBetter ? baseline * (1.0 - tolerance) : baseline * (1.0 + tolerance);
+            bool pass = higherIsBetter ? value >= limit : value <= limit;
+            double change = baseline > 0.0 ? (value - baseline) * 100.0 / baseline : 0.0;
+            std::printf("  %-18s %12.3f  baseline %12.3f  %+6.1f%%  %s\n", name, value, baseline, change,
+                        !gated ? "info" : (pass ? "ok" : "REGRESSION"));
+            ok = ok && (pass || !gated);
+        };
+        // ticks/sec × 校准毫秒数：机器快一倍时前者翻倍、后者减半，乘积不变
+        report("ticks/sec (norm)", m.ticksPerSec * m.calibrationMs / 1000.0,
+               baseTicksPerSec * baseCalibration / 1000.0, true, true);
+        report("peak RSS KB", static_cast<double>(m.peakRssKb), baseRss, false, true);
+        report("ticks/sec", m.ticksPerSec, baseTicksPerSec, true, false);
+        report("calibration ms", m.calibrationMs, baseCalibration, false, false);
+        report("p99 tick ms", m.p99Ms, baseP99, false, false);
+        return ok;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const char* scenarioName = nullptr;
+    std::string outputDir = ".";
+    std::string baselineDir;
+    double tolerance = 0.25;
+    const char* telemetryPath = nullptr;
+    const char* logPath = nullptr;
+    bool updateBaseline = false;
+    int repeat = 5;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--list") == 0)
+        {
+            for (const Scenario& s : kScenarios)
+                std::printf("%-14s %s\n", s.name, s.description);
+            return 0;
+        }
+        else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+            outputDir = argv[++i];
+        else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+            baselineDir = argv[++i];
+        else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+            tolerance = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc)
+            telemetryPath = argv[++i];
+        else if (std::strcmp(argv[i], "--log") == 0 && i + 1 < argc)
+            logPath = argv[++i];
+        else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+            repeat = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--update-baseline") == 0)
+            updateBaseline = true;
+        else
+            scenarioName = argv[i];
+    }
+
+    const Scenario* scenario = scenarioName ? FindScenario(scenarioName) : nullptr;
+    if (!scenario)
+    {
+        std::fprintf(stderr, "usage: scenario_runner <scenario> [--output DIR] [--baseline DIR] "
+                             "[--tolerance T] [--update-baseline] [--repeat N] [--telemetry FILE] [--log FILE]\n       scenario_runner --list\n");
+        return 2;
+    }
+
+    // 不创建窗口和渲染器；音频走 SDL 的 dummy 驱动，混音回调照常运行但不需要声卡
+    SDL_SetMainReady();
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    if (SDL_Init(SDL_INIT_TIMER | SDL_INIT_AUDIO) != 0)
+    {
+        std::fprintf(stderr, "scenario_runner: SDL_Init failed - %s\n", SDL_GetError());
+        return 2;
+    }
+    AudioInit();
+
+    // 关卡长度按卷轴速度算出，刚好走完（额外留出一屏和前方预加载的块）
+    std::string levelPath;
+    if (scenario->levelScrollSpeed > 0.0)
+    {
+        levelPath = outputDir + "/" + scenario->name + ".aclv";
+        double distance = scenario->ticks * scenario->levelScrollSpeed / TARGET_FPS + GAME_HEIGHT;
+        int chunks = static_cast<int>(distance / LEVEL_CHUNK_HEIGHT) + 1 + LEVEL_LOOKAHEAD_CHUNKS;
+        if (!LevelGenerate(levelPath.c_str(), chunks, kSeed))
+            return 2;
+    }
+
+    // 遥测和日志只记录第一次运行，之后的重复只计时
+    std::vector<Metrics> runs;
+    for (int r = 0; r < repeat; ++r)
+    {
+        if (r == 0 && telemetryPath)
+            TelemetryOpen(telemetryPath);
+        if (r == 0 && logPath)
+            LogOpen(logPath);
+        Metrics run = RunScenario(*scenario, levelPath);
+        TelemetryClose();
+        LogClose();
+        run.calibrationMs = RunCalibration();
+        runs.push_back(run);
+    }
+    Metrics m = MedianMetrics(runs);
+    std::printf("audio: %d commands dropped, %d voices stolen\n", AudioGetDroppedCommands(),
+                AudioGetStolenVoices());
+    AudioShutdown();
+    SDL_Quit();
+
+    std::printf("%s: %d ticks x %d runs (median)  %.0f ticks/sec  p50 %.3f ms  p99 %.3f ms  max %.3f ms  "
+                "calibration %.3f ms  peak RSS %ld KB\n",
+                scenario->name, m.ticks, repeat, m.ticksPerSec, m.p50Ms, m.p99Ms, m.maxMs, m.calibrationMs,
+                m.peakRssKb);
+
+    if (!WriteMetrics(outputDir + "/" + scenario->name + ".json", *scenario, m))
+        return 2;
+    if (baselineDir.empty())
+        return 0;
+
+    std::string baselinePath = baselineDir + "/" + scenario->name + ".json";
+    if (updateBaseline)
+    {
+        if (!WriteMetrics(baselinePath, *scenario, m))
+            return 2;
+        std::printf("  baseline updated: %s\n", baselinePath.c_str());
+        return 0;
+    }
+    if (scenario->minTolerance > tolerance)
+    {
+        std::printf("  tolerance raised to %.2f for %s\n", scenario->minTolerance, scenario->name);
+        tolerance = scenario->minTolerance;
+    }
+    return CompareWithBaseline(baselinePath, m, tolerance) ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+// 目标空间索引的查询开销测试
+// 在屏幕内随机放置 N 架敌机，比较网格索引与逐个扫描敌机数组的查询耗时，
+// 同时核对两者的结果（最近邻的距离、半径内的数量）完全一致
+//
+// 用法：spatial_bench [queries]    默认每种查询 100000 次
+
+#define SDL_MAIN_HANDLED
+#include "game_object/enemy.h"
+#include "game_object/spatial_index.h"
+#include "util/config.h"
+#include "util/util.h"
+
+#include <SDL.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    const int kEnemyCounts[] = {50, 200, 1000, 4000};
+    const int kNearestK = 8;
+    const double kRadius = 150.0;
+    const int kBuilds = 200;
+
+    volatile double g_sink = 0.0;  // 防止查询结果被优化掉
+
+    double NowSeconds()
+    {
+        return static_cast<double>(SDL_GetPerformanceCounter()) / static_cast<double>(SDL_GetPerformanceFrequency());
+    }
+
+    Vector2 EnemyCenter(const Enemy& e)
+    {
+        return {e.position.x + e.width / 2.0, e.position.y + e.height / 2.0};
+    }
+
+    double DistanceSq(Vector2 a, Vector2 b)
+    {
+        double dx = a.x - b.x;
+        double dy = a.y - b.y;
+        return dx * dx + dy * dy;
+    }
+
+    // 逐个扫描：维护前 k 近的距离（与索引相同的插入排序），返回个数
+    int LinearNearest(Vector2 position, int k, double* out)
+    {
+        const std::vector<Enemy>& enemies = GetEnemyBatch(ENEMY_TYPE_BASIC);
+        int found = 0;
+        for (const Enemy& e : enemies)
+        {
+            double d = DistanceSq(EnemyCenter(e), position);
+            if (found == k && d >= out[k - 1])
+                continue;
+            int i = found < k ? found++ : k - 1;
+            while (i > 0 && out[i - 1] > d)
+            {
+                out[i] = out[i - 1];
+                --i;
+            }
+            out[i] = d;
+        }
+        return found;
+    }
+
+    int LinearRadius(Vector2 position, double radius)
+    {
+        int count = 0;
+        for (const Enemy& e : GetEnemyBatch(ENEMY_TYPE_BASIC))
+            count += DistanceSq(EnemyCenter(e), position) <= radius * radius ? 1 : 0;
+        return count;
+    }
+
+    // 查询点覆盖整个屏幕，并包含少量屏幕外的点
+    Vector2 RandomPoint()
+    {
+        return {GetRandomDouble(-50.0, GAME_WIDTH + 50.0), GetRandomDouble(-50.0, GAME_HEIGHT + 50.0)};
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int queries = argc >= 2 ? std::atoi(argv[1]) : 100000;
+    if (queries <= 0)
+    {
+        std::fprintf(stderr, "usage: spatial_bench [queries]\n");
+        return 2;
+    }
+
+    SetRandomSeed(12345);
+    std::vector<Vector2> points(queries);
+    SpatialHit hits[kNearestK];
+    std::vector<SpatialHit> radiusHits(4096);
+    double linear[kNearestK];
+    int mismatches = 0;
+
+    std::printf("%8s %10s %22s %22s %22s\n", "enemies", "build_us", "nearest k=1 (ns)", "nearest k=8 (ns)",
+                "radius 150 (ns)");
+    std::printf("%8s %10s %22s %22s %22s\n", "", "", "index / linear", "index / linear", "index / linear");
+
+    for (int enemyCount : kEnemyCounts)
+    {
+        ClearEnemies();
+        SpatialIndexClear();
+        for (int i = 0; i < enemyCount; ++i)
+            CreateEnemy(GetRandomDouble(0.0, GAME_WIDTH - ENEMY_WIDTH), GetRandomDouble(-ENEMY_HEIGHT, GAME_HEIGHT));
+        for (Vector2& p : points)
+            p = RandomPoint();
+
+        double start = NowSeconds();
+        for (int b = 0; b < kBuilds; ++b)
+            SpatialIndexBuild();
+        double buildUs = (NowSeconds() - start) * 1e6 / kBuilds;
+
+        double ns[3][2];
+        const int ks[2] = {1, kNearestK};
+        for (int q = 0; q < 2; ++q)
+        {
+            int k = ks[q];
+            start = NowSeconds();
+            for (const Vector2& p : points)
+            {
+                int n = SpatialQueryNearest(p, k, hits);
+                g_sink += hits[n - 1].distanceSq;
+            }
+            ns[q][0] = (NowSeconds() - start) * 1e9 / queries;
+
+            start = NowSeconds();
+            for (const Vector2& p : points)
+            {
+                int n = LinearNearest(p, k, linear);
+                g_sink += linear[n - 1];
+            }
+            ns[q][1] = (NowSeconds() - start) * 1e9 / queries;
+
+            // 核对：第 1..k 近的距离完全相同（距离相等的目标顺序可能不同，所以比较距离而不是编号）
+            for (int i = 0; i < queries; i += 97)
+            {
+                int n = SpatialQueryNearest(points[i], k, hits);
+                int m = LinearNearest(points[i], k, linear);
+                bool same = n == m;
+                for (int j = 0; same && j < n; ++j)
+                    same = hits[j].distanceSq == linear[j];
+                mismatches += same ? 0 : 1;
+            }
+        }
+
+        start = NowSeconds();
+        for (const Vector2& p : points)
+            g_sink += SpatialQueryRadius(p, kRadius, radiusHits.data(), static_cast<int>(radiusHits.size()));
+        ns[2][0] = (NowSeconds() - start) * 1e9 / queries;
+
+        start = NowSeconds();
+        for (const Vector2& p : points)
+            g_sink += LinearRadius(p, kRadius);
+        ns[2][1] = (NowSeconds() - start) * 1e9 / queries;
+
+        for (int i = 0; i < queries; i += 97)
+        {
+            int n = SpatialQueryRadius(points[i], kRadius, radiusHits.data(), static_cast<int>(radiusHits.size()));
+            mismatches += n == LinearRadius(points[i], kRadius) ? 0 : 1;
+        }
+
+        std::printf("%8d %10.2f %10.1f / %9.1f %10.1f / %9.1f %10.1f / %9.1f\n", enemyCount, buildUs, ns[0][0],
+                    ns[0][1], ns[1][0], ns[1][1], ns[2][0], ns[2][1]);
+    }
+
+    std::printf("mismatches: %d\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
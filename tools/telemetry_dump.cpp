@@ -0,0 +1,145 @@
+// 遥测文件转 CSV 工具
+// 读取 --telemetry 写出的列式文件（格式见 src/util/telemetry.h），
+// 第一行是文件头中的列名，之后每个 tick 一行
+//
+// 用法：telemetry_dump <input> [output.csv]    不指定输出文件时写到标准输出
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const uint32_t kVersion = 1;
+
+    bool ReadBytes(FILE* file, void* data, size_t size)
+    {
+        return std::fread(data, 1, size, file) == size;
+    }
+
+    bool ReadU32(FILE* file, uint32_t& value)
+    {
+        uint8_t bytes[4];
+        if (!ReadBytes(file, bytes, 4))
+            return false;
+        value = static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+                static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+        return true;
+    }
+
+    // 解码一列：LEB128 变长整数 -> zigzag 还原 -> 累加差分
+    bool DecodeColumn(const std::vector<uint8_t>& data, uint32_t rows, std::vector<int32_t>& out)
+    {
+        out.resize(rows);
+        size_t pos = 0;
+        uint32_t previous = 0;
+        for (uint32_t i = 0; i < rows; ++i)
+        {
+            uint32_t zigzag = 0;
+            for (int shift = 0;; shift += 7)
+            {
+                if (pos >= data.size() || shift > 28)
+                    return false;
+                uint8_t byte = data[pos++];
+                zigzag |= static_cast<uint32_t>(byte & 0x7Fu) << shift;
+                if ((byte & 0x80u) == 0)
+                    break;
+            }
+            uint32_t delta = (zigzag >> 1) ^ (0u - (zigzag & 1u));
+            previous += delta;
+            out[i] = static_cast<int32_t>(previous);
+        }
+        return pos == data.size();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: telemetry_dump <input> [output.csv]\n");
+        return 2;
+    }
+
+    FILE* in = std::fopen(argv[1], "rb");
+    if (!in)
+    {
+        std::fprintf(stderr, "telemetry_dump: cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    // ===== 文件头 =====
+    char magic[4];
+    uint32_t version = 0, columnCount = 0;
+    if (!ReadBytes(in, magic, 4) || std::memcmp(magic, "ACTL", 4) != 0 || !ReadU32(in, version) ||
+        version != kVersion || !ReadU32(in, columnCount) || columnCount == 0)
+    {
+        std::fprintf(stderr, "telemetry_dump: %s is not a telemetry file (or has an unknown version)\n", argv[1]);
+        std::fclose(in);
+        return 1;
+    }
+
+    std::vector<std::string> names(columnCount);
+    for (std::string& name : names)
+    {
+        uint8_t length = 0;
+        bool ok = ReadBytes(in, &length, 1);
+        name.resize(length);
+        if (!ok || (length > 0 && !ReadBytes(in, &name[0], length)))
+        {
+            std::fprintf(stderr, "telemetry_dump: truncated header\n");
+            std::fclose(in);
+            return 1;
+        }
+    }
+
+    FILE* out = argc >= 3 ? std::fopen(argv[2], "w") : stdout;
+    if (!out)
+    {
+        std::fprintf(stderr, "telemetry_dump: cannot write %s\n", argv[2]);
+        std::fclose(in);
+        return 1;
+    }
+
+    for (uint32_t c = 0; c < columnCount; ++c)
+        std::fprintf(out, c + 1 < columnCount ? "%s," : "%s\n", names[c].c_str());
+
+    // ===== 数据块 =====
+    std::vector<std::vector<int32_t>> columns(columnCount);
+    std::vector<uint8_t> data;
+    int chunkCount = 0;
+    long long rowCount = 0;
+    int result = 0;
+    uint32_t rows = 0;
+    while (ReadU32(in, rows))
+    {
+        for (uint32_t c = 0; c < columnCount; ++c)
+        {
+            uint32_t size = 0;
+            bool ok = ReadU32(in, size);
+            data.resize(ok ? size : 0);
+            if (!ok || (size > 0 && !ReadBytes(in, data.data(), size)) || !DecodeColumn(data, rows, columns[c]))
+            {
+                std::fprintf(stderr, "telemetry_dump: chunk %d is truncated or corrupt\n", chunkCount);
+                result = 1;
+                break;
+            }
+        }
+        if (result != 0)
+            break;
+
+        for (uint32_t r = 0; r < rows; ++r)
+            for (uint32_t c = 0; c < columnCount; ++c)
+                std::fprintf(out, c + 1 < columnCount ? "%d," : "%d\n", columns[c][r]);
+        chunkCount++;
+        rowCount += rows;
+    }
+
+    std::fclose(in);
+    if (out != stdout)
+        std::fclose(out);
+    std::fprintf(stderr, "telemetry_dump: %lld ticks in %d chunks, %u columns\n", rowCount, chunkCount, columnCount);
+    return result;
+}